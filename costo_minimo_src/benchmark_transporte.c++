@@ -0,0 +1,251 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+
+#include "transporte.cpp"
+#include "lectura.cpp"
+
+/////////////////////////////////////////////////////////////////////
+// Benchmark del motor de transporte.                               //
+//                                                                   //
+// Genera instancias aleatorias balanceadas de n x n y reporta, por   //
+// método inicial, el tiempo de la solución inicial, el tiempo de     //
+// MODI y el número de pivotes hasta el óptimo. Antes revisa unos     //
+// casos chicos con óptimo conocido y que Reoptimizar llegue al mismo  //
+// óptimo que resolver desde cero sin dejar la solución anterior       //
+// y que la lectura de datos acepte enteros con signo '+' (termina    //
+// con error si algo falla).                                          //
+//                                                                   //
+// Uso: ./benchmark_transporte [n1 n2 ...]                            //
+/////////////////////////////////////////////////////////////////////
+
+using Reloj = std::chrono::steady_clock;
+
+static double Segundos(Reloj::time_point desde, Reloj::time_point hasta)
+{
+    return std::chrono::duration<double>(hasta - desde).count();
+}
+
+/**
+ * Instancia n x n con costos en [1, 100] y cantidades en [1, 1000];
+ * la última demanda se ajusta para que el problema quede balanceado.
+ */
+static void Generar(size_t n, unsigned semilla, TRP::Problema& problema, std::vector<int>& costos)
+{
+    std::mt19937 gen(semilla);
+    std::uniform_int_distribution<int> costo(1, 100);
+    std::uniform_int_distribution<long long> cantidad(1, 1000);
+
+    costos.resize(n * n);
+    for(auto& c : costos) c = costo(gen);
+
+    problema.oferta.assign(n, 0);
+    problema.demanda.assign(n, 0);
+    long long total = 0;
+    for(auto& o : problema.oferta){ o = cantidad(gen); total += o; }
+    for(size_t j = 0; j + 1 < n; j++){
+        long long d = std::min(cantidad(gen), total);
+        problema.demanda[j] = d;
+        total -= d;
+    }
+    problema.demanda[n - 1] = total;
+    problema.costos = costos.data();
+}
+
+// Caso chico con su costo óptimo conocido
+struct Caso
+{
+    const char* nombre;
+    std::vector<long long> oferta;
+    std::vector<long long> demanda;
+    std::vector<int> costos;
+    long long optimo;
+};
+
+/**
+ * Resuelve cada caso con los tres métodos iniciales y revisa que se llegue
+ * al óptimo conocido. Devuelve cuántas combinaciones fallaron.
+ */
+static int Verificar(const std::pair<TRP::Metodo, const char*>* metodos, size_t num_metodos)
+{
+    const Caso casos[] = {
+        {"libro 3x4", {7, 9, 18}, {5, 8, 7, 14},
+         {19, 30, 50, 10, 70, 30, 40, 60, 40, 8, 70, 20}, 743},
+        {"costos negativos", {5, 5}, {10}, {-3, -5}, -40},
+        {"negativos con ficticio", {10, 10}, {5, 5}, {-1, 2, 3, -4}, -25},
+    };
+    int fallas = 0;
+    for(const auto& caso : casos)
+    {
+        TRP::Problema problema;
+        problema.oferta = caso.oferta;
+        problema.demanda = caso.demanda;
+        problema.costos = caso.costos.data();
+        for(size_t k = 0; k < num_metodos; k++)
+        {
+            TRP::Opciones opciones;
+            opciones.metodo = metodos[k].first;
+            TRP::Solucion solucion;
+            bool ok = TRP::Resolver(problema, opciones, solucion)
+                && solucion.optima && solucion.costo_total == caso.optimo;
+            if(!ok)
+            {
+                std::cout << "FALLA " << caso.nombre << " (" << metodos[k].second << "): costo "
+                          << solucion.costo_total << ", se esperaba " << caso.optimo << "\n";
+                fallas++;
+            }
+        }
+    }
+    return fallas;
+}
+
+/**
+ * Cambia cantidades de una instancia balanceada de modo que aparezca un
+ * cliente ficticio, luego un almacén ficticio y al final vuelva a quedar
+ * balanceada, reoptimizando cada vez desde la base anterior. Revisa que
+ * ninguna reoptimización se haga desde cero y que el costo sea el mismo
+ * que al resolver desde cero. Devuelve cuántos pasos fallaron.
+ */
+static int Verificar_reoptimizar()
+{
+    TRP::Problema anterior;
+    std::vector<int> costos;
+    Generar(60, 777u, anterior, costos);
+    TRP::Opciones opciones;
+    TRP::Solucion solucion;
+    TRP::Resolver(anterior, opciones, solucion);
+
+    const struct { const char* nombre; size_t almacen; long long oferta; size_t cliente; long long demanda; } pasos[] = {
+        {"sube una oferta (cliente ficticio)", 3, 250, 0, 0},
+        {"sube una demanda (almacén ficticio)", 0, 0, 7, 900},
+        {"regresa al balance", 0, 0, 7, 0},
+    };
+    int fallas = 0;
+    TRP::Problema problema = anterior;
+    for(const auto& paso : pasos)
+    {
+        problema.oferta[paso.almacen] += paso.oferta;
+        problema.demanda[paso.cliente] += paso.demanda;
+        if(paso.demanda == 0 && paso.oferta == 0)
+        {
+            // Vuelve a balancear con la demanda del mismo cliente
+            long long o = std::accumulate(problema.oferta.begin(), problema.oferta.end(), 0LL);
+            long long d = std::accumulate(problema.demanda.begin(), problema.demanda.end(), 0LL);
+            problema.demanda[paso.cliente] += o - d;
+        }
+
+        TRP::Solucion caliente, desde_cero;
+        std::vector<TRP::Rango_costo> rangos;
+        TRP::Reoptimizar(anterior, solucion.base, problema, opciones, {}, caliente, rangos);
+        TRP::Resolver(problema, opciones, desde_cero);
+        if(!caliente.en_caliente || !caliente.optima || caliente.costo_total != desde_cero.costo_total)
+        {
+            std::cout << "FALLA reoptimizar, " << paso.nombre << ": "
+                      << (caliente.en_caliente ? "desde la anterior" : "desde cero")
+                      << ", costo " << caliente.costo_total << ", se esperaba " << desde_cero.costo_total << "\n";
+            fallas++;
+        }
+        anterior = problema;
+        solucion = caliente;
+    }
+    return fallas;
+}
+
+/**
+ * Revisa que LEC::Leer_enteros acepte un '+' delante de cada entero y
+ * siga rechazando lo que no es un entero. Devuelve cuántos casos fallaron.
+ */
+static int Verificar_lectura()
+{
+    const struct { const char* texto; std::vector<int> esperado; bool valido; } casos[] = {
+        {"+2 -3 4", {2, -3, 4}, true},
+        {"\t+10\r", {10}, true},
+        {"+-2", {}, false},
+        {"++2", {}, false},
+        {"+", {}, false},
+        {"2 x", {2}, false},
+    };
+    int fallas = 0;
+    for(const auto& caso : casos)
+    {
+        std::string texto = caso.texto;
+        std::vector<int> leidos;
+        long cuenta = LEC::Leer_enteros(texto.data(), texto.data() + texto.size(),
+                                        [&](int v){ leidos.push_back(v); });
+        bool ok = caso.valido ? (cuenta == (long)caso.esperado.size() && leidos == caso.esperado) : cuenta < 0;
+        if(!ok)
+        {
+            std::cout << "FALLA Leer_enteros(\"" << caso.texto << "\"): devolvió " << cuenta << "\n";
+            fallas++;
+        }
+    }
+    return fallas;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> tamanos;
+    for(int i = 1; i < argc; i++)
+        tamanos.push_back(std::strtoul(argv[i], nullptr, 10));
+    if(tamanos.empty())
+        tamanos = {100, 500, 1000, 2000, 5000};
+
+    const std::pair<TRP::Metodo, const char*> metodos[] = {
+        {TRP::Metodo::Esquina_noroeste, "noroeste"},
+        {TRP::Metodo::Costo_minimo, "costo"},
+        {TRP::Metodo::Vogel, "vogel"}
+    };
+
+    if(Verificar(metodos, 3) + Verificar_reoptimizar() + Verificar_lectura() > 0)
+        return 1;
+
+    std::cout << std::left << std::setw(8) << "n"
+              << std::setw(10) << "metodo"
+              << std::setw(14) << "costo_ini"
+              << std::setw(14) << "costo_opt"
+              << std::setw(10) << "pivotes"
+              << std::setw(12) << "t_ini(s)"
+              << std::setw(12) << "t_modi(s)"
+              << "t_total(s)\n";
+
+    for(size_t n : tamanos)
+    {
+        TRP::Problema problema;
+        std::vector<int> costos;
+        Generar(n, 12345u + (unsigned)n, problema, costos);
+
+        for(const auto& metodo : metodos)
+        {
+            // Solo la solución inicial, para separar su tiempo del de MODI
+            TRP::Opciones opciones;
+            opciones.metodo = metodo.first;
+            opciones.optimizar = false;
+            TRP::Solucion inicial;
+            auto t0 = Reloj::now();
+            TRP::Resolver(problema, opciones, inicial);
+            auto t1 = Reloj::now();
+
+            opciones.optimizar = true;
+            TRP::Solucion optima;
+            auto t2 = Reloj::now();
+            TRP::Resolver(problema, opciones, optima);
+            auto t3 = Reloj::now();
+
+            double t_ini = Segundos(t0, t1);
+            double t_total = Segundos(t2, t3);
+            std::cout << std::left << std::setw(8) << n
+                      << std::setw(10) << metodo.second
+                      << std::setw(14) << inicial.costo_total
+                      << std::setw(14) << optima.costo_total
+                      << std::setw(10) << optima.pivotes
+                      << std::setw(12) << std::fixed << std::setprecision(3) << t_ini
+                      << std::setw(12) << std::max(0.0, t_total - t_ini)
+                      << t_total << std::endl;
+        }
+    }
+    return 0;
+}
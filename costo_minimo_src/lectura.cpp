@@ -0,0 +1,416 @@
+#include <vector>
+#include <array>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// Lectura de "datos" y "resultados" sin copias.                      //
+//                                                                    //
+// Los archivos se mapean en memoria y los números se convierten con   //
+// std::from_chars directamente sobre el mapeo; la matriz de costos se //
+// escribe en un solo bloque contiguo (fila-mayor). Opcionalmente se   //
+// guarda una copia binaria ("datos.bin") que en corridas posteriores  //
+// se mapea y se usa tal cual, sin convertir nada.                     //
+//                                                                    //
+// Vigilante avisa cuando "datos" cambia en disco (inotify o, si no    //
+// está disponible, revisando tamaño y fecha de modificación).         //
+//////////////////////////////////////////////////////////////////////
+
+namespace LEC {
+
+    // Archivo de solo lectura mapeado en memoria
+    class Archivo_mapeado {
+        private:
+        const char* datos = nullptr;
+        size_t tam = 0;
+
+        public:
+        Archivo_mapeado() = default;
+        Archivo_mapeado(const Archivo_mapeado&) = delete;
+        Archivo_mapeado& operator=(const Archivo_mapeado&) = delete;
+        ~Archivo_mapeado() { Cerrar(); }
+
+        bool Abrir(const std::string& archivo){
+            Cerrar();
+            int fd = open(archivo.c_str(), O_RDONLY);
+            if(fd < 0)
+                return false;
+            struct stat st;
+            if(fstat(fd, &st) != 0){
+                close(fd);
+                return false;
+            }
+            tam = (size_t)st.st_size;
+            if(tam > 0){
+                void* p = mmap(nullptr, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(p == MAP_FAILED){
+                    close(fd);
+                    tam = 0;
+                    return false;
+                }
+                madvise(p, tam, MADV_SEQUENTIAL);
+                datos = static_cast<const char*>(p);
+            }
+            close(fd); // el mapeo sigue vigente sin el descriptor
+            return true;
+        }
+
+        void Cerrar(){
+            if(datos != nullptr)
+                munmap(const_cast<char*>(datos), tam);
+            datos = nullptr;
+            tam = 0;
+        }
+
+        const char* Datos() const { return datos; }
+        size_t Tam() const { return tam; }
+    };
+
+    /**
+     * Oferta, demanda y costos del problema. Los costos apuntan a
+     * costos_propios (leídos del texto) o directamente al archivo binario
+     * mapeado; en ambos casos son almacenes x clientes en orden fila-mayor.
+     */
+    struct Datos_transporte {
+        std::vector<int> oferta;
+        std::vector<int> demanda;
+        const int* costos = nullptr;
+        std::vector<int> costos_propios;
+        Archivo_mapeado mapeo;
+    };
+
+    // Cabecera del archivo binario; le siguen oferta, demanda y costos como int32
+    struct Cabecera_binaria {
+        char magia[8];
+        uint64_t almacenes;
+        uint64_t clientes;
+        uint64_t tam_fuente;    // tamaño y fecha del texto del que salió,
+        int64_t mtime_fuente;   // para saber si la copia sigue vigente
+    };
+    const char MAGIA[8] = {'T', 'R', 'P', 'B', 'I', 'N', '1', '\0'};
+
+    /**
+     * Recorre un buffer línea por línea. Se saltan las líneas que empiezan
+     * con "--" y las que no tienen números; por cada línea con números se
+     * llama a procesar(inicio, fin, num_linea).
+     */
+    template <typename F>
+    bool Recorrer_lineas(const char* p, const char* fin, F procesar){
+        size_t num_linea = 0;
+        while(p < fin){
+            const char* eol = static_cast<const char*>(memchr(p, '\n', fin - p));
+            if(eol == nullptr) eol = fin;
+            num_linea++;
+            bool comentario = (eol - p >= 2 && p[0] == '-' && p[1] == '-');
+            if(!comentario){
+                const char* q = p;
+                while(q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+                if(q < eol && !procesar(q, eol, num_linea))
+                    return false;
+            }
+            p = eol + 1;
+        }
+        return true;
+    }
+
+    /**
+     * Convierte los enteros de [p, fin) y los entrega a guardar(valor).
+     * Devuelve cuántos leyó, o -1 si encontró algo que no es un entero.
+     */
+    template <typename F>
+    long Leer_enteros(const char* p, const char* fin, F guardar){
+        long cuenta = 0;
+        while(true){
+            while(p < fin && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+            if(p >= fin)
+                return cuenta;
+            // from_chars no acepta el signo '+'; se salta uno, pero no "+-"
+            if(*p == '+' && p + 1 < fin && p[1] != '-') p++;
+            int valor;
+            auto [siguiente, error] = std::from_chars(p, fin, valor);
+            if(error != std::errc())
+                return -1;
+            guardar(valor);
+            cuenta++;
+            p = siguiente;
+        }
+    }
+
+    /**
+     * Lee el archivo de datos en formato de texto:
+     *   - primera línea: oferta de cada almacén
+     *   - segunda línea: demanda de cada cliente
+     *   - siguientes: una fila de costos por almacén
+     */
+    bool Leer_datos(const std::string& archivo, Datos_transporte& datos){
+        Archivo_mapeado texto;
+        if(!texto.Abrir(archivo)){
+            std::cerr << "No se pudo abrir el archivo: " << archivo << std::endl;
+            return false;
+        }
+        datos.oferta.clear();
+        datos.demanda.clear();
+        datos.costos_propios.clear();
+
+        size_t renglon = 0;
+        bool ok = Recorrer_lineas(texto.Datos(), texto.Datos() + texto.Tam(),
+            [&](const char* p, const char* fin, size_t num_linea){
+                long leidos;
+                if(renglon == 0){
+                    leidos = Leer_enteros(p, fin, [&](int v){ datos.oferta.push_back(v); });
+                }
+                else if(renglon == 1){
+                    leidos = Leer_enteros(p, fin, [&](int v){ datos.demanda.push_back(v); });
+                    datos.costos_propios.reserve(datos.oferta.size() * datos.demanda.size());
+                }
+                else{
+                    leidos = Leer_enteros(p, fin, [&](int v){ datos.costos_propios.push_back(v); });
+                    if(leidos >= 0 && (size_t)leidos != datos.demanda.size()){
+                        std::cerr << archivo << ":" << num_linea << ": se esperaban "
+                                  << datos.demanda.size() << " costos y hay " << leidos << "\n";
+                        return false;
+                    }
+                }
+                if(leidos < 0){
+                    std::cerr << archivo << ":" << num_linea << ": valor no numérico\n";
+                    return false;
+                }
+                renglon++;
+                return true;
+            });
+        if(!ok)
+            return false;
+
+        if(renglon < 2 || renglon - 2 != datos.oferta.size()){
+            std::cerr << "El archivo de datos no tiene el formato esperado: "
+                      << datos.oferta.size() << " almacenes y "
+                      << (renglon < 2 ? 0 : renglon - 2) << " filas de costos.\n";
+            return false;
+        }
+        datos.costos = datos.costos_propios.data();
+        return true;
+    }
+
+    static bool Estado_fuente(const std::string& fuente, uint64_t& tam, int64_t& mtime){
+        struct stat st;
+        if(stat(fuente.c_str(), &st) != 0)
+            return false;
+        tam = (uint64_t)st.st_size;
+        mtime = (int64_t)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+        return true;
+    }
+
+    /**
+     * Carga la copia binaria mapeándola; los costos quedan apuntando al mapeo.
+     * Devuelve false si no existe, está dañada o el texto fuente cambió desde
+     * que se escribió.
+     */
+    bool Leer_binario(const std::string& archivo_bin, const std::string& fuente, Datos_transporte& datos){
+        if(!datos.mapeo.Abrir(archivo_bin))
+            return false;
+        const char* p = datos.mapeo.Datos();
+        size_t tam = datos.mapeo.Tam();
+        Cabecera_binaria cab;
+        if(tam < sizeof(cab)){
+            datos.mapeo.Cerrar();
+            return false;
+        }
+        std::memcpy(&cab, p, sizeof(cab));
+
+        uint64_t tam_fuente = 0;
+        int64_t mtime_fuente = 0;
+        bool vigente = std::memcmp(cab.magia, MAGIA, sizeof(MAGIA)) == 0
+            && tam == sizeof(cab) + sizeof(int32_t) * (cab.almacenes + cab.clientes + cab.almacenes * cab.clientes)
+            && (!Estado_fuente(fuente, tam_fuente, mtime_fuente)
+                || (tam_fuente == cab.tam_fuente && mtime_fuente == cab.mtime_fuente));
+        if(!vigente){
+            datos.mapeo.Cerrar();
+            return false;
+        }
+
+        const int32_t* valores = reinterpret_cast<const int32_t*>(p + sizeof(cab));
+        datos.oferta.assign(valores, valores + cab.almacenes);
+        datos.demanda.assign(valores + cab.almacenes, valores + cab.almacenes + cab.clientes);
+        datos.costos = valores + cab.almacenes + cab.clientes;
+        datos.costos_propios.clear();
+        return true;
+    }
+
+    // Escribe la copia binaria (primero a un temporal y luego se renombra)
+    bool Escribir_binario(const std::string& archivo_bin, const std::string& fuente, const Datos_transporte& datos){
+        Cabecera_binaria cab;
+        std::memcpy(cab.magia, MAGIA, sizeof(MAGIA));
+        cab.almacenes = datos.oferta.size();
+        cab.clientes = datos.demanda.size();
+        cab.tam_fuente = 0;
+        cab.mtime_fuente = 0;
+        Estado_fuente(fuente, cab.tam_fuente, cab.mtime_fuente);
+
+        std::string temporal = archivo_bin + ".tmp";
+        std::ofstream out(temporal, std::ios::binary);
+        if(!out.is_open()){
+            std::cerr << "No se pudo escribir el archivo: " << temporal << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+        out.write(reinterpret_cast<const char*>(datos.oferta.data()), sizeof(int32_t) * cab.almacenes);
+        out.write(reinterpret_cast<const char*>(datos.demanda.data()), sizeof(int32_t) * cab.clientes);
+        out.write(reinterpret_cast<const char*>(datos.costos), sizeof(int32_t) * cab.almacenes * cab.clientes);
+        out.close();
+        if(!out || std::rename(temporal.c_str(), archivo_bin.c_str()) != 0){
+            std::cerr << "No se pudo escribir el archivo: " << archivo_bin << std::endl;
+            std::remove(temporal.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Lee "resultados": renglones "almacén cliente cantidad" y al final un
+     * renglón con un solo número, el costo total.
+     */
+    bool Leer_resultados(const std::string& archivo,
+                         std::vector<std::array<int, 3>>& asignaciones,
+                         long long& costo_total){
+        Archivo_mapeado texto;
+        if(!texto.Abrir(archivo)){
+            std::cerr << "No se pudo abrir el archivo: " << archivo << std::endl;
+            return false;
+        }
+        asignaciones.clear();
+        bool hay_costo = false;
+        bool ok = Recorrer_lineas(texto.Datos(), texto.Datos() + texto.Tam(),
+            [&](const char* p, const char* fin, size_t num_linea){
+                std::array<int, 3> fila {0, 0, 0};
+                long leidos = 0;
+                if(hay_costo){
+                    std::cerr << "Error en " << archivo << ": el último renglón debe ser el costo total.\n";
+                    return false;
+                }
+                // El costo puede no caber en int; se lee aparte
+                long long costo = 0;
+                auto [sig, error] = std::from_chars(p, fin, costo);
+                const char* q = sig;
+                while(q < fin && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+                if(error == std::errc() && q == fin){
+                    costo_total = costo;
+                    hay_costo = true;
+                    return true;
+                }
+                leidos = Leer_enteros(p, fin, [&](int v){ if(leidos < 3) fila[leidos] = v; leidos++; });
+                if(leidos < 3){
+                    std::cerr << archivo << ":" << num_linea << ": asignación inválida\n";
+                    return false;
+                }
+                asignaciones.push_back(fila);
+                return true;
+            });
+        if(ok && !hay_costo){
+            std::cerr << "Error en " << archivo << ": el último renglón debe ser el costo total.\n";
+            return false;
+        }
+        return ok;
+    }
+
+    /**
+     * Avisa cuando un archivo cambia. Con inotify se vigila su directorio
+     * (así también se detecta cuando un editor lo reemplaza renombrando un
+     * temporal); si no se puede, Cambio() solo compara tamaño y fecha de
+     * modificación. En ambos casos se reporta un cambio solo si el estado
+     * es distinto al último visto.
+     */
+    class Vigilante {
+        private:
+        std::string archivo;
+        std::string nombre;         // sin directorio, para filtrar eventos
+        int fd = -1;
+        uint64_t tam = 0;
+        int64_t mtime = 0;
+
+        bool Estado_cambio(){
+            uint64_t t = 0;
+            int64_t m = 0;
+            if(!Estado_fuente(archivo, t, m) || (t == tam && m == mtime))
+                return false;
+            tam = t;
+            mtime = m;
+            return true;
+        }
+
+        public:
+        Vigilante() = default;
+        Vigilante(const Vigilante&) = delete;
+        Vigilante& operator=(const Vigilante&) = delete;
+        ~Vigilante() { Detener(); }
+
+        // Devuelve true si se usa inotify, false si se revisará por sondeo
+        bool Iniciar(const std::string& archivo){
+            Detener();
+            this->archivo = archivo;
+            size_t barra = archivo.rfind('/');
+            nombre = (barra == std::string::npos) ? archivo : archivo.substr(barra + 1);
+            std::string directorio = (barra == std::string::npos) ? "." : archivo.substr(0, barra + 1);
+            Estado_fuente(archivo, tam, mtime);
+#ifdef __linux__
+            fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if(fd >= 0 && inotify_add_watch(fd, directorio.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0){
+                close(fd);
+                fd = -1;
+            }
+#endif
+            return fd >= 0;
+        }
+
+        void Detener(){
+            if(fd >= 0)
+                close(fd);
+            fd = -1;
+        }
+
+        /**
+         * Espera hasta espera_ms (0: no espera, -1: indefinidamente con
+         * inotify) a que el archivo cambie. Sin inotify no bloquea: el que
+         * llama decide cada cuánto volver a preguntar.
+         */
+        bool Cambio(int espera_ms = 0){
+            if(fd < 0)
+                return Estado_cambio();
+#ifdef __linux__
+            struct pollfd pfd { fd, POLLIN, 0 };
+            bool tocado = false;
+            while(poll(&pfd, 1, espera_ms) > 0){
+                alignas(struct inotify_event) char bufer[4096];
+                ssize_t leidos;
+                while((leidos = read(fd, bufer, sizeof(bufer))) > 0){
+                    for(char* p = bufer; p < bufer + leidos;){
+                        auto* evento = reinterpret_cast<struct inotify_event*>(p);
+                        if(evento->len > 0 && nombre == evento->name)
+                            tocado = true;
+                        p += sizeof(struct inotify_event) + evento->len;
+                    }
+                }
+                if(tocado && Estado_cambio())
+                    return true;
+                tocado = false;
+                if(espera_ms >= 0)
+                    break;
+            }
+#endif
+            return false;
+        }
+    };
+}
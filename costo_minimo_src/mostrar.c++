@@ -2,11 +2,23 @@
 #include <fstream>
 #include <vector>
 #include <string>
-#include <sstream>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <utility>
 
 // Incluimos la librería donde están definidas las clases Screen, Color, etc.
 #include "../SDL_Visor/SDL_Visor.hpp"  // Ajusta a tu nombre real, p. ej. "screen.h" o algo similar
 
+// Motor del problema de transporte (costo mínimo, noroeste, Vogel y MODI)
+#include "transporte.cpp"
+
+// Lectura de "datos" y "resultados" con mmap, copia binaria opcional y vigilancia
+#include "lectura.cpp"
+
+// Atlas de glifos y vista desplazable para dibujar la tabla
+#include "tabla.cpp"
+
 // Para simplificar referencias:
 using std::vector;
 using std::string;
@@ -16,353 +28,520 @@ using std::string;
 //////////////////////////////////////////////////
 
 /**
- * Lee el archivo "datos.txt" y llena la estructura de datos:
- *   - fila 0: oferta de cada almacén
- *   - fila 1: demanda de cada cliente
- *   - filas restantes: matriz de costos de envío (almacenes x clientes)
+ * Lee el archivo "datos" (ver lectura.cpp para el formato). La matriz de
+ * costos queda en un solo bloque contiguo [almacen * c + cliente].
+ *
+ * Con usar_binario se intenta primero la copia binaria "<datos>.bin"; si no
+ * existe o el texto cambió desde que se escribió, se lee el texto y se
+ * vuelve a generar la copia para la siguiente corrida.
  */
 bool leerDatos(const std::string& archivo_datos,
-               std::vector<std::vector<int>>& datos)
+               bool usar_binario,
+               LEC::Datos_transporte& datos)
 {
-    std::ifstream in(archivo_datos);
-    if(!in.is_open())
-    {
-        std::cerr << "No se pudo abrir el archivo: " << archivo_datos << std::endl;
-        return false;
-    }
+    std::string archivo_bin = archivo_datos + ".bin";
+    if(usar_binario && LEC::Leer_binario(archivo_bin, archivo_datos, datos))
+        return true;
 
-    std::string linea;
-    while(std::getline(in, linea))
-    {
-        // Ignoramos comentarios o líneas vacías
-        if(linea.empty() || linea.rfind("--", 0) == 0)
-            continue;
-        
-        std::istringstream iss(linea);
-        int valor;
-        vector<int> fila;
-        while(iss >> valor)
-        {
-            fila.push_back(valor);
-        }
+    if(!LEC::Leer_datos(archivo_datos, datos))
+        return false;
 
-        if(!fila.empty())
-            datos.push_back(fila);
-    }
-    in.close();
+    if(usar_binario)
+        LEC::Escribir_binario(archivo_bin, archivo_datos, datos);
     return true;
 }
 
 /**
  * Lee el archivo "resultados.txt" y:
- *   - llena un vector temporal con las asignaciones (almacén, cliente, cantidad)
- *   - el último número leido lo interpreta como coste total
+ *   - llena las asignaciones (almacén, cliente, cantidad)
+ *   - el último renglón, de un solo número, lo interpreta como coste total
  */
 bool leerResultados(const std::string& archivo_resultados,
-                    std::vector<std::vector<int>>& asignaciones,
-                    int& costo_total)
+                    std::vector<std::array<int, 3>>& asignaciones,
+                    long long& costo_total)
 {
-    std::ifstream in(archivo_resultados);
-    if(!in.is_open())
-    {
-        std::cerr << "No se pudo abrir el archivo: " << archivo_resultados << std::endl;
-        return false;
-    }
+    return LEC::Leer_resultados(archivo_resultados, asignaciones, costo_total);
+}
+
+//////////////////////////////////////////////////////////////
+// Funciones para convertir datos a una estructura interna. //
+//////////////////////////////////////////////////////////////
 
-    std::string linea;
-    vector<vector<int>> temp;
-    while(std::getline(in, linea))
+/**
+ * A partir de los datos leídos de "resultados.txt":
+ *   - asignaciones = (almacén, cliente, cantidad)
+ *   - se construye una matriz shipments[w][c] con la cantidad enviada
+ */
+void procesarResultados(const std::vector<std::array<int, 3>>& asignaciones,
+                        size_t w, size_t c,
+                        vector<vector<int>>& shipments)
+{
+    shipments.resize(w, vector<int>(c, 0));
+    for(const auto& fila : asignaciones)
     {
-        if(linea.empty()) 
-            continue;
+        int almacen = fila[0];
+        int cliente = fila[1];
+        int cantidad = fila[2];
 
-        std::istringstream iss(linea);
-        int valor;
-        vector<int> fila;
-        while(iss >> valor)
+        // Ojo: si en el archivo los almacenes y clientes empiezan en 1,
+        // ajustamos a índice base 0
+        if(almacen >= 1 && almacen <= (int)w &&
+           cliente >= 1 && cliente <= (int)c)
         {
-            fila.push_back(valor);
+            shipments[almacen - 1][cliente - 1] = cantidad;
+        }
+        else
+        {
+            std::cerr << "Asignación inválida en resultados.txt: " 
+                      << almacen << ", " << cliente 
+                      << ", " << cantidad << std::endl;
         }
-
-        if(!fila.empty())
-            temp.push_back(fila);
     }
-    in.close();
+}
 
-    // El último renglón debe ser el costo total (un único valor).
-    // El resto se consideran asignaciones [almacen, cliente, cantidad].
-    if(!temp.empty())
+//////////////////////////////////////////////////////////
+// Funciones para resolver el problema de transporte.   //
+//////////////////////////////////////////////////////////
+
+// El motor usa la misma matriz contigua, sin copiarla
+TRP::Problema problemaTransporte(const LEC::Datos_transporte& datos)
+{
+    TRP::Problema problema;
+    problema.oferta.assign(datos.oferta.begin(), datos.oferta.end());
+    problema.demanda.assign(datos.demanda.begin(), datos.demanda.end());
+    problema.costos = datos.costos;
+    return problema;
+}
+
+/**
+ * Pasa la base de la solución al formato de "resultados": asignaciones
+ * [almacen, cliente, cantidad] con índices base 1, sin las celdas vacías ni
+ * las del almacén/cliente ficticio.
+ */
+void asignacionesDeSolucion(const TRP::Solucion& solucion,
+                            size_t w, size_t c,
+                            std::vector<std::array<int, 3>>& asignaciones)
+{
+    asignaciones.clear();
+    for(const auto& celda : solucion.base)
     {
-        // El último vector de la lista debería tener 1 valor
-        vector<int>& ultima_fila = temp.back();
-        if(ultima_fila.size() == 1)
-        {
-            costo_total = ultima_fila[0];
-            temp.pop_back();
-        }
-        else
+        if(celda.almacen < w && celda.cliente < c && celda.cantidad > 0)
         {
-            std::cerr << "Error en resultados.txt: el último renglón debe ser el costo total.\n";
-            return false;
+            asignaciones.push_back({(int)celda.almacen + 1,
+                                    (int)celda.cliente + 1,
+                                    (int)celda.cantidad});
         }
     }
-    // Copiamos todo lo demás a "asignaciones"
-    asignaciones = temp;
+}
+
+/**
+ * Resuelve el problema con el motor TRP y deja el resultado con el mismo
+ * formato que "resultados". En base queda la base completa (con las celdas
+ * degeneradas) para poder reoptimizar desde ella.
+ */
+bool resolverTransporte(const LEC::Datos_transporte& datos,
+                        TRP::Metodo metodo,
+                        std::vector<std::array<int, 3>>& asignaciones,
+                        long long& costo_total,
+                        std::vector<TRP::Asignacion>& base)
+{
+    TRP::Opciones opciones;
+    opciones.metodo = metodo;
+    TRP::Solucion solucion;
+    if(!TRP::Resolver(problemaTransporte(datos), opciones, solucion))
+        return false;
+
+    asignacionesDeSolucion(solucion, datos.oferta.size(), datos.demanda.size(), asignaciones);
+    costo_total = solucion.costo_total;
+    base = solucion.base;
 
+    std::cout << "Costo inicial: " << solucion.costo_inicial
+              << "  Costo óptimo: " << solucion.costo_total
+              << "  Pivotes MODI: " << solucion.pivotes << std::endl;
     return true;
 }
 
-//////////////////////////////////////////////////////////////
-// Funciones para convertir datos a una estructura interna. //
-//////////////////////////////////////////////////////////////
-
 /**
- * A partir de los datos leídos de "datos.txt":
- *  - fila 0 = vector<int> con la oferta de cada almacén
- *  - fila 1 = vector<int> con la demanda de cada cliente
- *  - fila 2 en adelante = matriz de costos
+ * Escribe las asignaciones y el costo total con el formato de "resultados",
+ * para que el archivo siga sirviendo a otras herramientas.
  */
-void procesarDatos(const std::vector<std::vector<int>>& datos,
-                   vector<int>& oferta,
-                   vector<int>& demanda,
-                   vector<vector<int>>& costos)
+bool escribirResultados(const std::string& archivo_resultados,
+                        const std::vector<std::array<int, 3>>& asignaciones,
+                        long long costo_total)
 {
-    if(datos.size() < 3)
+    std::ofstream out(archivo_resultados);
+    if(!out.is_open())
     {
-        std::cerr << "El archivo de datos no tiene el formato esperado.\n";
-        return;
+        std::cerr << "No se pudo escribir el archivo: " << archivo_resultados << std::endl;
+        return false;
     }
+    for(const auto& fila : asignaciones)
+    {
+        out << fila[0] << " " << fila[1] << " " << fila[2] << "\n";
+    }
+    out << costo_total;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////
+// Reoptimización cuando "datos" cambia (modo --vigilar).   //
+//////////////////////////////////////////////////////////////
 
-    // fila 0 -> oferta
-    oferta = datos[0];
-    // fila 1 -> demanda
-    demanda = datos[1];
+// Máximo de celdas con costo cambiado para las que se reporta su rango
+const size_t MAX_RANGOS = 50;
 
-    // las filas restantes son la matriz de costos
-    size_t w = oferta.size();   // número de almacenes
-    size_t c = demanda.size();  // número de clientes
-    costos.resize(w, vector<int>(c, 0));
+// Diferencias entre dos versiones de "datos" (índices base 0)
+struct CambiosDatos
+{
+    bool misma_forma = true;                        // mismos almacenes y clientes
+    vector<size_t> almacenes;                       // oferta distinta
+    vector<size_t> clientes;                        // demanda distinta
+    vector<std::pair<size_t, size_t>> celdas;       // costo distinto
 
-    // A partir de la fila 2, tenemos w filas
-    // datos[2], datos[3], ..., datos[2 + w - 1]
-    // cada fila es de largo c
+    bool Vacio() const
+    {
+        return misma_forma && almacenes.empty() && clientes.empty() && celdas.empty();
+    }
+};
+
+void compararDatos(const LEC::Datos_transporte& antes,
+                   const LEC::Datos_transporte& despues,
+                   CambiosDatos& cambios)
+{
+    cambios = CambiosDatos();
+    size_t w = despues.oferta.size();
+    size_t c = despues.demanda.size();
+    if(antes.oferta.size() != w || antes.demanda.size() != c)
+    {
+        cambios.misma_forma = false;
+        return;
+    }
+    for(size_t i = 0; i < w; i++)
+        if(antes.oferta[i] != despues.oferta[i]) cambios.almacenes.push_back(i);
+    for(size_t j = 0; j < c; j++)
+        if(antes.demanda[j] != despues.demanda[j]) cambios.clientes.push_back(j);
     for(size_t i = 0; i < w; i++)
     {
+        const int* fila_antes = antes.costos + i * c;
+        const int* fila_despues = despues.costos + i * c;
+        if(std::equal(fila_antes, fila_antes + c, fila_despues))
+            continue;
         for(size_t j = 0; j < c; j++)
-        {
-            costos[i][j] = datos[2 + i][j];
-        }
+            if(fila_antes[j] != fila_despues[j]) cambios.celdas.push_back({i, j});
     }
 }
 
+static std::string textoLimite(long long valor)
+{
+    if(valor == TRP::SIN_LIMITE) return "inf";
+    if(valor == -TRP::SIN_LIMITE) return "-inf";
+    return std::to_string(valor);
+}
+
 /**
- * A partir de los datos leídos de "resultados.txt":
- *   - asignaciones = (almacén, cliente, cantidad)
- *   - se construye una matriz shipments[w][c] con la cantidad enviada
+ * Vuelve a resolver con los datos nuevos partiendo de la solución actual en
+ * lugar de empezar de cero, y reporta qué cambió, cómo se resolvió y los
+ * rangos de costo de las celdas cambiadas.
+ *
+ * Se parte de base si se tiene; si no (p. ej. con --resultados), de los
+ * envíos de shipments, que no incluyen las celdas degeneradas y por eso
+ * suelen requerir más pivotes.
  */
-void procesarResultados(const std::vector<std::vector<int>>& asignaciones,
-                        size_t w, size_t c,
-                        vector<vector<int>>& shipments)
+bool reoptimizarTransporte(const LEC::Datos_transporte& anterior,
+                           const LEC::Datos_transporte& datos,
+                           const CambiosDatos& cambios,
+                           TRP::Metodo metodo,
+                           const vector<vector<int>>& shipments,
+                           std::vector<std::array<int, 3>>& asignaciones,
+                           long long& costo_total,
+                           std::vector<TRP::Asignacion>& base)
 {
-    shipments.resize(w, vector<int>(c, 0));
-    for(const auto& fila : asignaciones)
+    std::vector<TRP::Asignacion> previas = base;
+    if(previas.empty())
     {
-        if(fila.size() < 3) 
-            continue; // ignorar malformados
+        for(size_t i = 0; i < shipments.size(); i++)
+            for(size_t j = 0; j < shipments[i].size(); j++)
+                if(shipments[i][j] > 0) previas.push_back(TRP::Asignacion{i, j, shipments[i][j]});
+    }
 
-        int almacen = fila[0];
-        int cliente = fila[1];
-        int cantidad = fila[2];
+    std::vector<std::pair<size_t, size_t>> celdas(cambios.celdas.begin(),
+        cambios.celdas.begin() + std::min(cambios.celdas.size(), MAX_RANGOS));
 
-        // Ojo: si en el archivo los almacenes y clientes empiezan en 1,
-        // ajustamos a índice base 0
-        if(almacen >= 1 && almacen <= (int)w &&
-           cliente >= 1 && cliente <= (int)c)
-        {
-            shipments[almacen - 1][cliente - 1] = cantidad;
-        }
-        else
+    TRP::Opciones opciones;
+    opciones.metodo = metodo;
+    TRP::Solucion solucion;
+    std::vector<TRP::Rango_costo> rangos;
+    auto inicio = std::chrono::steady_clock::now();
+    if(!TRP::Reoptimizar(problemaTransporte(anterior), previas, problemaTransporte(datos),
+                         opciones, celdas, solucion, rangos))
+        return false;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+
+    long long costo_anterior = costo_total;
+    asignacionesDeSolucion(solucion, datos.oferta.size(), datos.demanda.size(), asignaciones);
+    costo_total = solucion.costo_total;
+    base = solucion.base;
+
+    if(cambios.misma_forma)
+        std::cout << "Cambios: " << cambios.almacenes.size() << " ofertas, "
+                  << cambios.clientes.size() << " demandas, " << cambios.celdas.size() << " costos\n";
+    else
+        std::cout << "Cambiaron las dimensiones: " << datos.oferta.size() << " x " << datos.demanda.size() << "\n";
+    std::cout << (solucion.en_caliente ? "Desde la solución anterior" : "Desde cero")
+              << "  Pivotes de reparación: " << solucion.pivotes_reparacion
+              << "  Pivotes MODI: " << solucion.pivotes
+              << "  Tiempo: " << ms << " ms\n";
+    std::cout << "Costo óptimo: " << costo_anterior << " -> " << costo_total << std::endl;
+
+    if(!rangos.empty())
+    {
+        std::cout << "Rangos de costo (la base sigue siendo óptima dentro del rango):\n";
+        for(const auto& rango : rangos)
         {
-            std::cerr << "Asignación inválida en resultados.txt: " 
-                      << almacen << ", " << cliente 
-                      << ", " << cantidad << std::endl;
+            std::cout << "  Alm " << rango.almacen + 1 << ", Cliente " << rango.cliente + 1
+                      << ": costo " << rango.costo
+                      << " en [" << textoLimite(rango.minimo) << ", " << textoLimite(rango.maximo) << "]";
+            if(rango.basica)
+                std::cout << "  envía " << rango.cantidad << "\n";
+            else
+                std::cout << "  sin envío, conviene si baja de " << rango.minimo << "\n";
         }
+        if(cambios.celdas.size() > rangos.size())
+            std::cout << "  ... y " << cambios.celdas.size() - rangos.size() << " celdas más\n";
     }
+    std::cout << std::flush;
+    return true;
+}
+
+/**
+ * Se llama cuando el archivo de datos cambió: lo lee en el búfer libre, lo
+ * compara con el vigente y, si hay diferencias, reoptimiza, reescribe
+ * "resultados" y reconstruye shipments. El búfer anterior se conserva para
+ * la siguiente comparación. Devuelve true si la solución cambió.
+ */
+bool actualizarTransporte(const std::string& archivo_datos,
+                          bool usar_binario,
+                          TRP::Metodo metodo,
+                          LEC::Datos_transporte (&buferes)[2],
+                          int& actual,
+                          vector<vector<int>>& shipments,
+                          std::vector<std::array<int, 3>>& asignaciones,
+                          long long& costo_total,
+                          std::vector<TRP::Asignacion>& base)
+{
+    LEC::Datos_transporte& nuevos = buferes[1 - actual];
+    if(!leerDatos(archivo_datos, usar_binario, nuevos))
+    {
+        std::cerr << "Se conserva la solución anterior." << std::endl;
+        return false;
+    }
+    CambiosDatos cambios;
+    compararDatos(buferes[actual], nuevos, cambios);
+    if(cambios.Vacio())
+        return false;
+
+    if(!reoptimizarTransporte(buferes[actual], nuevos, cambios, metodo, shipments, asignaciones, costo_total, base))
+        return false;
+    actual = 1 - actual;
+    escribirResultados("resultados", asignaciones, costo_total);
+
+    // procesarResultados solo agrega lo que falta; se empieza de una matriz vacía
+    shipments.clear();
+    procesarResultados(asignaciones, nuevos.oferta.size(), nuevos.demanda.size(), shipments);
+    return true;
 }
 
 /////////////////////////////////////////////////////
 // Función para dibujar la tabla con la librería.  //
 /////////////////////////////////////////////////////
 
+// Vista de la tabla; la modifica el manejador de eventos
+TAB::Vista vista_tabla;
+bool redibujar_tabla = true;
+
+const std::string FUENTE_TABLA = "../SDL_Visor/fonts/NotoSans/NotoSans-Bold.ttf";
+
 /**
- * Dibuja la tabla en la ventana. La tabla tendrá:
- *  - Filas = w + 1 (almacenes + 1 fila para la demanda)
- *  - Columnas = c + 1 (clientes + 1 columna para la oferta)
+ * Dibuja en la ventana la parte visible de la tabla:
+ *  - Filas = w + 2 (encabezado, almacenes y la fila de la demanda)
+ *  - Columnas = c + 2 (encabezado, clientes y la columna de la oferta)
  *
  * Estructura conceptual (índices de la tabla):
  *       C0      C1     C2     ...      C(c)
- *  R0   ""    Clien1  Clien2  ...    ClienC
+ *  R0   ""    Clien1  Clien2  ...    ClienC   Oferta
  *  R1   Alm1    cost     cost  ...      cost  |   oferta(Alm1)
  *  R2   Alm2    cost     cost  ...      cost  |   oferta(Alm2)
  *  ...
  *  Rw   AlmW    cost     cost  ...      cost  |   oferta(AlmW)
- * 
- *  (demanda) en la última fila
- * 
+ *       Demanda (demanda de cada cliente)
+ *
+ *  costos es la matriz contigua w x c (fila-mayor).
+ *
  *  En cost se mostrará:
  *     - solo el costo de envío si shipments[i][j] == 0
- *     - costo + "(" + cantidad + ")" si shipments[i][j] > 0
+ *     - costo + "(" + cantidad + ")" si shipments[i][j] > 0, con la celda resaltada
+ *
+ * La fila R0 y la columna C0 quedan fijas al desplazarse. Solo se recorren
+ * las celdas que caen en la ventana y el texto sale del atlas de glifos,
+ * que se vuelve a construir únicamente cuando el zoom cambia el tamaño de
+ * la fuente. Con celdas muy chicas se omite el texto y solo quedan
+ * resaltadas las celdas con envío.
  */
 void dibujarTabla(
     vsr::Screen& screen,
+    const TAB::Vista& vista,
+    TAB::Atlas_glifos& atlas_celdas,
+    TAB::Atlas_glifos& atlas_barra,
     const vector<int>& oferta,
     const vector<int>& demanda,
-    const vector<vector<int>>& costos,
+    const int* costos,
     const vector<vector<int>>& shipments,
-    int costo_envios
+    long long costo_envios
 )
 {
+    SDL_Renderer* renderer = screen.Get_renderer();
+
     // Cantidades
     size_t w = oferta.size();   // n almacenes
     size_t c = demanda.size();  // n clientes
 
-    // Dimensiones visuales de cada celda (ajusta a tu gusto).
-    const int cellWidth  = 100;
-    const int cellHeight = 40;
-
-    // Posición inicial de la tabla en la ventana
-    const int startX = 50;
-    const int startY = 50;
+    // Dimensiones de cada celda con el zoom actual
+    const int cellWidth  = vista.Ancho_celda();
+    const int cellHeight = vista.Alto_celda();
+    const int tableBottom = vista.alto - TAB::ALTO_BARRA;
 
     // Colores básicos
-    vsr::Color colorLineas(0,0,0);         // negro para líneas
-    vsr::Color colorTexto(0,0,0);         // texto en negro
-    vsr::Color colorResaltado(255,255,0); // amarillo (si quieres destacar algo)
-
-    // Fuente default (asume que tu Screen ya tiene una fuente cargada o usa la default)
-    // Si no, llama a: screen.Load_font("default", "ruta.ttf", 16); etc.
-
-    //////////////////////////////////////////////////
-    // DIBUJAR LÍNEAS DE LA TABLA (GRILLA)
-    //////////////////////////////////////////////////
-    // Filas totales = w + 1 (almacenes) + 1 (cabecera) + 1 (fila de demandas) = w + 2
-    // Columnas totales = c + 1 (clientes) + 1 (columna de ofertas) = c + 2
-    int rowCount = (int)w + 2; // +1 para encabezado, +1 para fila de demanda
-    int colCount = (int)c + 2; // +1 para encabezado, +1 para columna de oferta
-
-    // Dibujar líneas horizontales
-    for(int r = 0; r <= rowCount; r++)
+    // (los rellenos y el texto van directo al renderer, con SDL_Color)
+    vsr::Color colorLineas(0,0,0);                         // negro para líneas
+    const SDL_Color colorTexto{0, 0, 0, 255};              // texto en negro
+    const SDL_Color colorResaltado{255, 255, 0, 255};      // amarillo para las celdas con envío
+    const SDL_Color colorEncabezado{230, 230, 230, 255};   // fondo de la fila y columna fijas
+    const SDL_Color colorBarra{210, 210, 210, 255};
+
+    // La fuente sigue al zoom; el atlas solo se rehace si cambia de tamaño
+    bool conTexto = vista.Tam_fuente() >= TAB::TAM_FUENTE_MIN;
+    if(conTexto && atlas_celdas.Tam() != vista.Tam_fuente())
     {
-        int y = startY + r * cellHeight;
-        screen.Draw_line_pos(startX, y, startX + colCount * cellWidth, y, colorLineas);
-    }
-    // Dibujar líneas verticales
-    for(int col = 0; col <= colCount; col++)
-    {
-        int x = startX + col * cellWidth;
-        screen.Draw_line_pos(x, startY, x, startY + rowCount * cellHeight, colorLineas);
+        atlas_celdas.Construir(renderer, FUENTE_TABLA, vista.Tam_fuente());
     }
+    conTexto = conTexto && atlas_celdas.Listo();
+    const bool conRejilla = cellWidth >= 4 && cellHeight >= 4;
 
-    //////////////////////////////////////////////////
-    // ESCRIBIR CONTENIDO DE CADA CELDA
-    //////////////////////////////////////////////////
-    //  R0, C0 (vacío), R0, C1..C(c) (nombres de clientes),
-    //  R1..R(w), C0 (nombres de almacenes),
-    //  R(w+1), C1..C(c) (demandas),
-    //  R1..R(w), C(c+1) (ofertas)
-
-    // (A) R0, C1..C(c): nombres de clientes
-    for(size_t j = 0; j < c; j++)
+    // Escribe una etiqueta dentro de la celda con esquina (x, y)
+    const int margen = std::max(1, cellWidth / 20);
+    auto escribir = [&](int x, int y, const TAB::Etiqueta& etiqueta)
     {
-        int cellX = startX + (j+1)*cellWidth; 
-        int cellY = startY; // cabecera
-        // Texto "Cliente j+1" o lo que desees
-        std::ostringstream oss;
-        oss << "Cliente " << (j+1);
-        screen.Show_text(cellX + 5, cellY + 5, String(oss.str()), colorTexto);
-    }
+        atlas_celdas.Dibujar(renderer, x + margen, y + (cellHeight - atlas_celdas.Alto()) / 2,
+                             etiqueta.texto, etiqueta.largo, x + cellWidth - 1, colorTexto);
+    };
 
-    // (B) R1..R(w), C0: nombres de almacenes
-    for(size_t i = 0; i < w; i++)
-    {
-        int cellX = startX; 
-        int cellY = startY + (i+1)*cellHeight;
-        std::ostringstream oss;
-        oss << "Alm " << (i+1);
-        screen.Show_text(cellX + 5, cellY + 5, oss.str(), colorTexto);
-    }
+    // Celdas visibles del cuerpo: filas 0..w (w = demanda), columnas 0..c (c = oferta)
+    size_t fila_ini, fila_fin, col_ini, col_fin;
+    vista.Filas_visibles(fila_ini, fila_fin);
+    vista.Columnas_visibles(col_ini, col_fin);
 
-    // (C) Celdas de costos (R1..R(w), C1..C(c))
-    for(size_t i = 0; i < w; i++)
+    //////////////////////////////////////////////////
+    // (A) CUERPO: costos (con la cantidad enviada), ofertas y demandas
+    //////////////////////////////////////////////////
+    for(size_t i = fila_ini; i < fila_fin; i++)
     {
-        for(size_t j = 0; j < c; j++)
+        int cellY = vista.Y_fila(i);
+        for(size_t j = col_ini; j < col_fin; j++)
         {
-            int cellX = startX + (j+1)*cellWidth;
-            int cellY = startY + (i+1)*cellHeight;
-
-            int cost = costos[i][j];
-            int sent = shipments[i][j];
-
-            // Si no hay venta, solo mostramos el costo
-            // Si hay venta, mostramos "cost(cantidad)"
-            std::ostringstream oss;
-            if(sent == 0)
+            int cellX = vista.X_columna(j);
+            TAB::Etiqueta etiqueta;
+            if(i < w && j < c)
             {
-                oss << cost;
+                int cost = costos[i * c + j];
+                int sent = shipments[i][j];
+                if(sent != 0)
+                {
+                    TAB::Rellenar(renderer, cellX, cellY, cellWidth, cellHeight, colorResaltado);
+                    etiqueta << cost << "(" << sent << ")";
+                }
+                else
+                {
+                    etiqueta << cost;
+                }
             }
-            else
+            else if(i < w)
+            {
+                etiqueta << oferta[i];
+            }
+            else if(j < c)
             {
-                oss << cost << "(" << sent << ")";
+                etiqueta << demanda[j];
+            }
+            if(conTexto && etiqueta.largo > 0)
+            {
+                escribir(cellX, cellY, etiqueta);
             }
-            screen.Show_text(cellX + 5, cellY + 5, oss.str(), colorTexto);
         }
     }
 
-    // (D) Última fila (R = w+1) con las demandas
+    // Rejilla del cuerpo (solo las líneas visibles)
+    if(conRejilla && fila_ini < fila_fin && col_ini < col_fin)
     {
-        int rowY = startY + (w+1)*cellHeight;
-        for(size_t j = 0; j < c; j++)
+        int x0 = cellWidth, x1 = std::min(vista.ancho - 1, vista.X_columna(col_fin));
+        int y0 = cellHeight, y1 = std::min(tableBottom - 1, vista.Y_fila(fila_fin));
+        for(size_t j = col_ini; j <= col_fin; j++)
         {
-            int cellX = startX + (j+1)*cellWidth;
-            std::ostringstream oss;
-            oss << demanda[j];
-            screen.Show_text(cellX + 5, rowY + 5, oss.str(), colorTexto);
+            int x = vista.X_columna(j);
+            if(x >= x0 && x <= x1)
+                screen.Draw_line_pos(x, y0, x, y1, colorLineas);
         }
-        // Texto "Demanda" en C0
+        for(size_t i = fila_ini; i <= fila_fin; i++)
         {
-            int cellX = startX;
-            screen.Show_text(cellX + 5, rowY + 5, "Demanda", colorTexto);
+            int y = vista.Y_fila(i);
+            if(y >= y0 && y <= y1)
+                screen.Draw_line_pos(x0, y, x1, y, colorLineas);
         }
     }
 
-    // (E) Última columna (C = c+1) con las ofertas de cada almacén
+    //////////////////////////////////////////////////
+    // (B) ENCABEZADOS FIJOS: clientes / "Oferta" arriba, almacenes / "Demanda" a la izquierda
+    //////////////////////////////////////////////////
+    TAB::Rellenar(renderer, 0, 0, vista.ancho, cellHeight, colorEncabezado);
+    TAB::Rellenar(renderer, 0, cellHeight, cellWidth, std::max(0, tableBottom - cellHeight), colorEncabezado);
+    for(size_t j = col_ini; j < col_fin && conTexto; j++)
     {
-        for(size_t i = 0; i < w; i++)
-        {
-            int cellX = startX + (c+1)*cellWidth;
-            int cellY = startY + (i+1)*cellHeight;
-
-            std::ostringstream oss;
-            oss << oferta[i];
-            screen.Show_text(cellX + 5, cellY + 5, oss.str(), colorTexto);
-        }
-        // Texto "Oferta" en R0
-        {
-            int cellX = startX + (c+1)*cellWidth;
-            int cellY = startY;
-            screen.Show_text(cellX + 5, cellY + 5, "Oferta", colorTexto);
-        }
+        TAB::Etiqueta etiqueta;
+        if(j < c)
+            etiqueta << "Cliente " << (long long)(j + 1);
+        else
+            etiqueta << "Oferta";
+        escribir(vista.X_columna(j), 0, etiqueta);
+    }
+    for(size_t i = fila_ini; i < fila_fin && conTexto; i++)
+    {
+        TAB::Etiqueta etiqueta;
+        if(i < w)
+            etiqueta << "Alm " << (long long)(i + 1);
+        else
+            etiqueta << "Demanda";
+        escribir(0, vista.Y_fila(i), etiqueta);
+    }
+    TAB::Rellenar(renderer, 0, 0, cellWidth, cellHeight, colorEncabezado);  // esquina vacía
+    if(conRejilla)
+    {
+        screen.Draw_line_pos(0, cellHeight, vista.ancho - 1, cellHeight, colorLineas);
+        screen.Draw_line_pos(cellWidth, 0, cellWidth, tableBottom - 1, colorLineas);
     }
 
     //////////////////////////////////////////////////
-    // TEXTO FINAL: "Coste de los envíos: ..."
+    // (C) BARRA INFERIOR: "Coste de los envíos: ..." y lo que se está viendo
     //////////////////////////////////////////////////
     {
-        int finalTextX = startX;
-        int finalTextY = startY + (rowCount*cellHeight) + 30; 
-        std::ostringstream oss;
-        oss << "Coste de los envios: $" << costo_envios;
-        screen.Show_text(finalTextX, finalTextY, oss.str(), colorTexto);
+        TAB::Rellenar(renderer, 0, tableBottom, vista.ancho, TAB::ALTO_BARRA, colorBarra);
+        TAB::Etiqueta etiqueta;
+        etiqueta << "Coste de los envios: $" << costo_envios;
+        etiqueta << "   Alm " << (long long)std::min(fila_ini + 1, w) << "-" << (long long)std::min(fila_fin, w)
+                 << " de " << (long long)w;
+        etiqueta << ", clientes " << (long long)std::min(col_ini + 1, c) << "-" << (long long)std::min(col_fin, c)
+                 << " de " << (long long)c;
+        etiqueta << ", zoom " << std::lround(vista.zoom * 100) << "%";
+        atlas_barra.Dibujar(renderer, 10, tableBottom + (TAB::ALTO_BARRA - atlas_barra.Alto()) / 2,
+                            etiqueta.texto, etiqueta.largo, vista.ancho, colorTexto);
     }
 }
 
@@ -372,34 +551,89 @@ void dibujarTabla(
 
 int main(int argc, char* argv[])
 {
-    // 1) Leer y procesar el archivo "datos"
-    std::vector<std::vector<int>> datos;
-    if(!leerDatos("datos", datos))
+    // Uso: ./mostrar.out [archivo_datos] [vogel|costo|noroeste|--resultados|--binario|--vigilar|--sin_ventana]
+    //   --resultados  muestra el archivo "resultados" ya existente sin resolver.
+    //   --binario     usa (y mantiene) la copia binaria "<archivo_datos>.bin".
+    //   --vigilar     sigue corriendo y, cada vez que el archivo de datos cambia,
+    //                 reoptimiza partiendo de los envíos actuales.
+    //   --sin_ventana no abre la ventana (con --vigilar solo reporta en consola).
+    std::string archivo_datos = "datos";
+    TRP::Metodo metodo = TRP::Metodo::Vogel;
+    bool usar_resultados = false;
+    bool usar_binario = false;
+    bool vigilar = false;
+    bool sin_ventana = false;
+    for(int i = 1; i < argc; i++)
     {
-        return 1;
+        std::string arg = argv[i];
+        if(arg == "vogel")            metodo = TRP::Metodo::Vogel;
+        else if(arg == "costo")       metodo = TRP::Metodo::Costo_minimo;
+        else if(arg == "noroeste")    metodo = TRP::Metodo::Esquina_noroeste;
+        else if(arg == "--resultados") usar_resultados = true;
+        else if(arg == "--binario")   usar_binario = true;
+        else if(arg == "--vigilar")   vigilar = true;
+        else if(arg == "--sin_ventana") sin_ventana = true;
+        else                          archivo_datos = arg;
     }
 
-    // 2) Leer y procesar el archivo "resultados"
-    std::vector<std::vector<int>> asignaciones;
-    int costo_envios = 0;
-    if(!leerResultados("resultados", asignaciones, costo_envios))
+    // 1) Leer el archivo "datos": oferta, demanda y matriz de costos contigua.
+    //    Hay dos búferes para que, al vigilar, la versión anterior siga
+    //    disponible para compararla con la nueva.
+    LEC::Datos_transporte buferes[2];
+    int actual = 0;
+    if(!leerDatos(archivo_datos, usar_binario, buferes[actual]))
     {
         return 1;
     }
+    LEC::Vigilante vigilante;
+    if(vigilar && !vigilante.Iniciar(archivo_datos))
+    {
+        std::cerr << "inotify no disponible; se revisará " << archivo_datos << " periódicamente." << std::endl;
+    }
 
-    // 3) Extraer de "datos" la oferta, la demanda y la matriz de costos
-    vector<int> oferta;
-    vector<int> demanda;
-    vector<vector<int>> costos; // [almacen][cliente]
-    procesarDatos(datos, oferta, demanda, costos);
+    // 2) Resolver el problema (o leer un "resultados" previo)
+    std::vector<std::array<int, 3>> asignaciones;
+    std::vector<TRP::Asignacion> base;     // base completa, si se resolvió aquí
+    long long costo_envios = 0;
+    if(usar_resultados)
+    {
+        if(!leerResultados("resultados", asignaciones, costo_envios))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        if(!resolverTransporte(buferes[actual], metodo, asignaciones, costo_envios, base))
+        {
+            return 1;
+        }
+        escribirResultados("resultados", asignaciones, costo_envios);
+    }
 
-    // 4) A partir de las asignaciones, construir la matriz "shipments"
+    // 3) A partir de las asignaciones, construir la matriz "shipments"
     //    con la cantidad enviada por [almacen][cliente]
-    size_t w = oferta.size();
-    size_t c = demanda.size();
+    size_t w = buferes[actual].oferta.size();
+    size_t c = buferes[actual].demanda.size();
     vector<vector<int>> shipments;
     procesarResultados(asignaciones, w, c, shipments);
 
+    if(sin_ventana)
+    {
+        // Sin inotify Cambio() no espera; se pregunta cada medio segundo
+        while(vigilar)
+        {
+            if(!vigilante.Cambio(-1))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                continue;
+            }
+            actualizarTransporte(archivo_datos, usar_binario, metodo, buferes, actual,
+                                 shipments, asignaciones, costo_envios, base);
+        }
+        return 0;
+    }
+
     // -------------------------------------------------------------
     // A continuación, inicializamos SDL y creamos nuestra ventana.
     // Usamos la clase vsr::Screen. Ajusta ancho/alto a tu preferencia.
@@ -417,13 +651,25 @@ int main(int argc, char* argv[])
     screen.Init_TTF("default", "../SDL_Visor/fonts/NotoSans/NotoSans-Bold.ttf", 18); 
     screen.Set_default_font("default");
 
-    // Event handler vacío (por si no queremos hacer nada especial con los eventos).
+    // Atlas de glifos: el de las celdas sigue al zoom, el de la barra es fijo
+    TAB::Atlas_glifos atlas_celdas;
+    TAB::Atlas_glifos atlas_barra;
+    atlas_barra.Construir(screen.Get_renderer(), FUENTE_TABLA, TAB::TAM_FUENTE);
+
+    vista_tabla.almacenes = w;
+    vista_tabla.clientes = c;
+    screen.Get_window_sizes(&vista_tabla.ancho, &vista_tabla.alto);
+
+    // Rueda, arrastre y teclado desplazan o acercan la tabla
     auto eventHandler = [](SDL_Event& e){
-        // Aquí podrías manejar clicks, etc.  
+        if(TAB::Atender_evento(vista_tabla, e))
+        {
+            redibujar_tabla = true;
+        }
     };
     screen.Set_events_handler(eventHandler);
 
-    // Bucle principal
+    // Bucle principal: solo se dibuja cuando algo cambió
     bool running = true;
     while(running)
     {
@@ -433,15 +679,42 @@ int main(int argc, char* argv[])
             running = false;
         }
 
-        // Limpiamos la pantalla con color blanco, por ejemplo
-        vsr::Color blanco(255,255,255);
-        screen.Clean_screen(blanco);
+        if(vigilar && vigilante.Cambio(0)
+           && actualizarTransporte(archivo_datos, usar_binario, metodo, buferes, actual,
+                                   shipments, asignaciones, costo_envios, base))
+        {
+            vista_tabla.almacenes = buferes[actual].oferta.size();
+            vista_tabla.clientes = buferes[actual].demanda.size();
+            vista_tabla.Limitar();
+            redibujar_tabla = true;
+        }
 
-        // Dibujamos la tabla
-        dibujarTabla(screen, oferta, demanda, costos, shipments, costo_envios);
+        if(redibujar_tabla)
+        {
+            // Limpiamos la pantalla con color blanco
+            vsr::Color blanco(255,255,255);
+            screen.Clean_screen(blanco);
+
+            // Dibujamos la parte visible de la tabla
+            const LEC::Datos_transporte& datos = buferes[actual];
+            dibujarTabla(screen, vista_tabla, atlas_celdas, atlas_barra,
+                         datos.oferta, datos.demanda, datos.costos, shipments, costo_envios);
+
+            // Mostramos lo que se dibujó
+            screen.Present_renderer();
+            redibujar_tabla = false;
+        }
 
-        // Mostramos lo que se dibujó
-        screen.Present_renderer();
+        // Esperar el siguiente evento sin sacarlo de la cola (lo atiende Handle_events);
+        // al vigilar se despierta cada tanto para revisar el archivo
+        if(running && vigilar)
+        {
+            SDL_WaitEventTimeout(nullptr, 250);
+        }
+        else if(running)
+        {
+            SDL_WaitEvent(nullptr);
+        }
     }
 
     return 0;
@@ -0,0 +1,292 @@
+#include <string>
+#include <charconv>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+
+//////////////////////////////////////////////////////////////////////
+// Piezas para dibujar tablas grandes de forma virtual.               //
+//                                                                    //
+// Los caracteres se rasterizan una sola vez por tamaño de fuente en   //
+// una textura (atlas) y el texto se dibuja copiando rectángulos de    //
+// ella. La vista guarda el desplazamiento y el zoom, y calcula qué    //
+// filas y columnas caen en la ventana; así el costo de cada cuadro    //
+// depende del tamaño de la ventana y no del de la tabla.              //
+//////////////////////////////////////////////////////////////////////
+
+namespace TAB {
+
+    const int ANCHO_CELDA = 100;    // tamaño de celda con zoom 1
+    const int ALTO_CELDA = 40;
+    const int ALTO_BARRA = 30;      // barra inferior con el costo
+    const int TAM_FUENTE = 18;
+    const int TAM_FUENTE_MIN = 8;   // con menos ya no se escribe en las celdas
+    const double ZOOM_MIN = 0.05;
+    const double ZOOM_MAX = 4.0;
+    const double PASO_ZOOM = 1.25;
+
+    const char PRIMER_GLIFO = ' ';
+    const char ULTIMO_GLIFO = '~';
+    const int NUM_GLIFOS = ULTIMO_GLIFO - PRIMER_GLIFO + 1;
+    const int ANCHO_ATLAS = 1024;
+
+    // Rellena un rectángulo directamente con el renderer
+    void Rellenar(SDL_Renderer* renderer, int x, int y, int ancho, int alto, const SDL_Color& color){
+        SDL_Rect rect{ x, y, ancho, alto };
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRect(renderer, &rect);
+    }
+
+    // Caracteres ASCII imprimibles de una fuente, en una sola textura
+    class Atlas_glifos {
+        private:
+        SDL_Texture* textura = nullptr;
+        SDL_Rect glifos[NUM_GLIFOS];
+        int avance[NUM_GLIFOS];
+        int alto = 0;
+        int tam = 0;
+
+        public:
+        Atlas_glifos() = default;
+        Atlas_glifos(const Atlas_glifos&) = delete;
+        Atlas_glifos& operator=(const Atlas_glifos&) = delete;
+        ~Atlas_glifos() { Liberar(); }
+
+        /**
+         * Rasteriza los glifos de la fuente con el tamaño dado (en blanco,
+         * el color se aplica al dibujar) y los acomoda en renglones de
+         * ANCHO_ATLAS píxeles.
+         */
+        bool Construir(SDL_Renderer* renderer, const std::string& fuente, int tam){
+            Liberar();
+            if(!TTF_WasInit() && TTF_Init() != 0)
+                return false;
+            TTF_Font* font = TTF_OpenFont(fuente.c_str(), tam);
+            if(font == nullptr){
+                std::cerr << "No se pudo abrir la fuente: " << fuente << " (" << SDL_GetError() << ")\n";
+                return false;
+            }
+
+            SDL_Color blanco{ 255, 255, 255, 255 };
+            SDL_Surface* superficies[NUM_GLIFOS];
+            alto = TTF_FontHeight(font);
+            int x = 0, y = 0;
+            for(int g = 0; g < NUM_GLIFOS; g++){
+                Uint16 caracter = (Uint16)(PRIMER_GLIFO + g);
+                superficies[g] = TTF_RenderGlyph_Blended(font, caracter, blanco);
+                avance[g] = 0;
+                TTF_GlyphMetrics(font, caracter, nullptr, nullptr, nullptr, nullptr, &avance[g]);
+                int ancho_glifo = superficies[g] ? superficies[g]->w : 0;
+                int alto_glifo = superficies[g] ? superficies[g]->h : 0;
+                if(x + ancho_glifo > ANCHO_ATLAS){
+                    x = 0;
+                    y += alto;
+                }
+                glifos[g] = SDL_Rect{ x, y, ancho_glifo, std::min(alto_glifo, alto) };
+                x += ancho_glifo;
+            }
+            TTF_CloseFont(font);
+
+            SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, ANCHO_ATLAS, y + alto, 32, SDL_PIXELFORMAT_RGBA8888);
+            for(int g = 0; g < NUM_GLIFOS; g++){
+                if(superficies[g] == nullptr)
+                    continue;
+                if(atlas != nullptr){
+                    // Copiar también el canal alfa, sin mezclar
+                    SDL_SetSurfaceBlendMode(superficies[g], SDL_BLENDMODE_NONE);
+                    SDL_Rect destino = glifos[g];
+                    SDL_BlitSurface(superficies[g], nullptr, atlas, &destino);
+                }
+                SDL_FreeSurface(superficies[g]);
+            }
+            if(atlas == nullptr)
+                return false;
+            textura = SDL_CreateTextureFromSurface(renderer, atlas);
+            SDL_FreeSurface(atlas);
+            if(textura == nullptr)
+                return false;
+            SDL_SetTextureBlendMode(textura, SDL_BLENDMODE_BLEND);
+            this->tam = tam;
+            return true;
+        }
+
+        void Liberar(){
+            if(textura != nullptr)
+                SDL_DestroyTexture(textura);
+            textura = nullptr;
+            tam = 0;
+        }
+
+        bool Listo() const { return textura != nullptr; }
+        int Tam() const { return tam; }
+        int Alto() const { return alto; }
+
+        /**
+         * Dibuja texto con la esquina superior izquierda en (x, y); se corta en
+         * el primer carácter que pasaría de x_max. Los caracteres fuera del
+         * atlas se muestran como '?'.
+         */
+        void Dibujar(SDL_Renderer* renderer, int x, int y, const char* texto, size_t largo, int x_max, const SDL_Color& color){
+            if(textura == nullptr)
+                return;
+            SDL_SetTextureColorMod(textura, color.r, color.g, color.b);
+            for(size_t i = 0; i < largo; i++){
+                char caracter = texto[i];
+                if(caracter < PRIMER_GLIFO || caracter > ULTIMO_GLIFO)
+                    caracter = '?';
+                int g = caracter - PRIMER_GLIFO;
+                const SDL_Rect& origen = glifos[g];
+                if(x + origen.w > x_max)
+                    break;
+                SDL_Rect destino{ x, y, origen.w, origen.h };
+                SDL_RenderCopy(renderer, textura, &origen, &destino);
+                x += avance[g];
+            }
+        }
+    };
+
+    // Texto corto armado sin reservar memoria: etiqueta << "Cliente " << j
+    struct Etiqueta {
+        char texto[64];
+        size_t largo = 0;
+
+        Etiqueta& operator<<(const char* s){
+            size_t n = std::min(std::strlen(s), sizeof(texto) - largo);
+            std::memcpy(texto + largo, s, n);
+            largo += n;
+            return *this;
+        }
+        Etiqueta& operator<<(long long valor){
+            auto [fin, error] = std::to_chars(texto + largo, texto + sizeof(texto), valor);
+            if(error == std::errc())
+                largo = fin - texto;
+            return *this;
+        }
+    };
+
+    /**
+     * Parte visible de una tabla de almacenes x clientes. La fila y la
+     * columna de encabezados quedan fijas; el cuerpo (almacenes + la fila
+     * de demanda, clientes + la columna de oferta) se desplaza debajo de
+     * ellas. x, y es el desplazamiento del cuerpo en píxeles.
+     */
+    struct Vista {
+        size_t almacenes = 0;
+        size_t clientes = 0;
+        int ancho = 0;              // tamaño de la ventana
+        int alto = 0;
+        double zoom = 1.0;
+        double x = 0, y = 0;
+
+        int Ancho_celda() const { return std::max(1, (int)std::lround(ANCHO_CELDA * zoom)); }
+        int Alto_celda() const { return std::max(1, (int)std::lround(ALTO_CELDA * zoom)); }
+        int Ancho_cuerpo() const { return std::max(0, ancho - Ancho_celda()); }
+        int Alto_cuerpo() const { return std::max(0, alto - ALTO_BARRA - Alto_celda()); }
+        int Tam_fuente() const { return (int)std::lround(TAM_FUENTE * zoom); }
+
+        // Mantiene el desplazamiento dentro de la tabla
+        void Limitar(){
+            double max_x = (double)(clientes + 1) * Ancho_celda() - Ancho_cuerpo();
+            double max_y = (double)(almacenes + 1) * Alto_celda() - Alto_cuerpo();
+            x = std::max(0.0, std::min(x, max_x));
+            y = std::max(0.0, std::min(y, max_y));
+        }
+
+        bool Desplazar(double dx, double dy){
+            double antes_x = x, antes_y = y;
+            x += dx;
+            y += dy;
+            Limitar();
+            return x != antes_x || y != antes_y;
+        }
+
+        // Cambia el zoom dejando fijo el punto de la ventana (px, py)
+        bool Acercar(double factor, int px, int py){
+            double nuevo = std::max(ZOOM_MIN, std::min(zoom * factor, ZOOM_MAX));
+            if(nuevo == zoom)
+                return false;
+            double cx = x + px - Ancho_celda();
+            double cy = y + py - Alto_celda();
+            double razon = nuevo / zoom;
+            zoom = nuevo;
+            x = cx * razon - (px - Ancho_celda());
+            y = cy * razon - (py - Alto_celda());
+            Limitar();
+            return true;
+        }
+
+        // Rango [inicio, fin) de celdas del cuerpo que caen en "visible" píxeles
+        static void Rango(double desplazamiento, int celda, int visible, size_t total, size_t& inicio, size_t& fin){
+            inicio = std::min(total, (size_t)(desplazamiento / celda));
+            fin = visible > 0 ? std::min(total, (size_t)std::ceil((desplazamiento + visible) / celda)) : inicio;
+        }
+        void Columnas_visibles(size_t& inicio, size_t& fin) const { Rango(x, Ancho_celda(), Ancho_cuerpo(), clientes + 1, inicio, fin); }
+        void Filas_visibles(size_t& inicio, size_t& fin) const { Rango(y, Alto_celda(), Alto_cuerpo(), almacenes + 1, inicio, fin); }
+
+        // Posición en la ventana de la columna / fila j del cuerpo
+        int X_columna(size_t j) const { return Ancho_celda() + (int)std::floor((double)j * Ancho_celda() - x); }
+        int Y_fila(size_t i) const { return Alto_celda() + (int)std::floor((double)i * Alto_celda() - y); }
+    };
+
+    /**
+     * Aplica un evento a la vista; devuelve true si hay que volver a dibujar.
+     *   rueda: desplazar (con Shift, horizontal; con Ctrl, zoom bajo el cursor)
+     *   arrastrar con el botón izquierdo: desplazar
+     *   flechas, RePág/AvPág, Inicio/Fin: desplazar
+     *   + y -: zoom; 0: zoom original
+     */
+    bool Atender_evento(Vista& vista, const SDL_Event& evento){
+        switch(evento.type){
+            case SDL_WINDOWEVENT:
+                if(evento.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || evento.window.event == SDL_WINDOWEVENT_RESIZED){
+                    vista.ancho = evento.window.data1;
+                    vista.alto = evento.window.data2;
+                    vista.Limitar();
+                    return true;
+                }
+                return evento.window.event == SDL_WINDOWEVENT_EXPOSED;
+
+            case SDL_MOUSEWHEEL: {
+                Uint16 mod = SDL_GetModState();
+                if(mod & KMOD_CTRL){
+                    int px, py;
+                    SDL_GetMouseState(&px, &py);
+                    return vista.Acercar(evento.wheel.y > 0 ? PASO_ZOOM : 1 / PASO_ZOOM, px, py);
+                }
+                double dx = evento.wheel.x * vista.Ancho_celda();
+                double dy = -evento.wheel.y * 3.0 * vista.Alto_celda();
+                if(mod & KMOD_SHIFT)
+                    std::swap(dx, dy);
+                return vista.Desplazar(dx, dy);
+            }
+
+            case SDL_MOUSEMOTION:
+                if(evento.motion.state & SDL_BUTTON_LMASK)
+                    return vista.Desplazar(-evento.motion.xrel, -evento.motion.yrel);
+                return false;
+
+            case SDL_KEYDOWN: {
+                int centro_x = vista.ancho / 2, centro_y = vista.alto / 2;
+                switch(evento.key.keysym.sym){
+                    case SDLK_LEFT:     return vista.Desplazar(-vista.Ancho_celda(), 0);
+                    case SDLK_RIGHT:    return vista.Desplazar(vista.Ancho_celda(), 0);
+                    case SDLK_UP:       return vista.Desplazar(0, -vista.Alto_celda());
+                    case SDLK_DOWN:     return vista.Desplazar(0, vista.Alto_celda());
+                    case SDLK_PAGEUP:   return vista.Desplazar(0, -vista.Alto_cuerpo());
+                    case SDLK_PAGEDOWN: return vista.Desplazar(0, vista.Alto_cuerpo());
+                    case SDLK_HOME:     return vista.Desplazar(-vista.x, -vista.y);
+                    case SDLK_END:      return vista.Desplazar(0, INFINITY);
+                    case SDLK_PLUS:
+                    case SDLK_EQUALS:
+                    case SDLK_KP_PLUS:  return vista.Acercar(PASO_ZOOM, centro_x, centro_y);
+                    case SDLK_MINUS:
+                    case SDLK_KP_MINUS: return vista.Acercar(1 / PASO_ZOOM, centro_x, centro_y);
+                    case SDLK_0:        return vista.Acercar(1 / vista.zoom, centro_x, centro_y);
+                    default:            return false;
+                }
+            }
+        }
+        return false;
+    }
+}
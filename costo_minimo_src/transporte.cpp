@@ -0,0 +1,890 @@
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <unordered_map>
+
+//////////////////////////////////////////////////////////////////////
+// Motor del problema de transporte.                                 //
+//                                                                    //
+// Trabaja sobre una matriz de costos plana en orden fila-mayor       //
+// (almacenes x clientes). Ofrece tres soluciones iniciales (costo    //
+// mínimo, esquina noroeste y Vogel) y la optimización por MODI       //
+// (potenciales u-v) hasta llegar al óptimo.                          //
+//                                                                    //
+// Si la oferta total no coincide con la demanda total se agrega un   //
+// almacén o cliente ficticio con costo 0; sus índices son m y n      //
+// respectivamente dentro de la base.                                 //
+//                                                                    //
+// Reoptimizar parte de una solución anterior cuando cambian algunas   //
+// cantidades o costos (si hace falta agrega el ficticio del otro lado //
+// y conserva el anterior con cantidad 0), y Rangos_costo da el        //
+// intervalo en el que puede moverse el costo de una celda sin que la  //
+// base deje de ser óptima.                                            //
+//////////////////////////////////////////////////////////////////////
+
+namespace TRP {
+
+    enum class Metodo { Costo_minimo, Esquina_noroeste, Vogel };
+
+    struct Problema {
+        std::vector<long long> oferta;   // una entrada por almacén
+        std::vector<long long> demanda;  // una entrada por cliente
+        const int* costos = nullptr;     // oferta.size() x demanda.size(), fila-mayor
+    };
+
+    // Celda de la base, índices base 0
+    struct Asignacion {
+        size_t almacen;
+        size_t cliente;
+        long long cantidad;
+    };
+
+    struct Solucion {
+        size_t filas = 0;                // almacenes, contando el ficticio si existe
+        size_t columnas = 0;             // clientes, contando el ficticio si existe
+        std::vector<Asignacion> base;    // filas + columnas - 1 celdas (incluye degeneradas)
+        long long costo_inicial = 0;     // costo de la solución inicial
+        long long costo_total = 0;       // costo tras la optimización
+        size_t pivotes = 0;
+        size_t pivotes_reparacion = 0;   // pivotes duales para corregir flujos negativos
+        bool optima = false;
+        bool en_caliente = false;        // se partió de la solución anterior
+    };
+
+    const long long SIN_LIMITE = std::numeric_limits<long long>::max();
+
+    /**
+     * Intervalo [minimo, maximo] en el que puede estar el costo de una celda
+     * sin que cambie la base óptima (±SIN_LIMITE si no hay límite). En una
+     * celda no básica "reducido" es cuánto tendría que bajar su costo para
+     * convenir usarla.
+     */
+    struct Rango_costo {
+        size_t almacen;
+        size_t cliente;
+        long long costo;
+        bool basica;
+        long long cantidad;
+        long long reducido;
+        long long minimo;
+        long long maximo;
+    };
+
+    struct Opciones {
+        Metodo metodo = Metodo::Vogel;
+        bool optimizar = true;                                      // ejecutar MODI
+        size_t max_pivotes = std::numeric_limits<size_t>::max();
+    };
+
+    class Transporte {
+        private:
+        const int* costos;
+        size_t m, n;          // dimensiones originales
+        size_t filas, cols;   // dimensiones con ficticios
+        std::vector<long long> oferta, demanda;
+
+        // Base: cada arista une la fila i (nodo i) con la columna j (nodo filas + j)
+        std::vector<size_t> arista_fila, arista_col;
+        std::vector<long long> flujo;
+        std::vector<std::vector<size_t>> adyacentes;
+
+        // Árbol calculado en cada pivote
+        std::vector<long long> potencial;   // u para filas, v para columnas
+        std::vector<size_t> padre;          // arista hacia el padre
+        std::vector<size_t> profundidad;
+        std::vector<size_t> pila;
+        std::vector<size_t> orden;          // nodos en el orden del recorrido
+
+        size_t siguiente_bloque = 0;
+        size_t pivotes = 0;
+        size_t reparaciones = 0;
+
+        static constexpr size_t NINGUNO = std::numeric_limits<size_t>::max();
+
+        long long Costo(size_t i, size_t j) const {
+            return (i < m && j < n) ? costos[i * n + j] : 0;
+        }
+        void Agregar_arista(size_t i, size_t j, long long cantidad);
+        void Quitar_adyacencia(size_t nodo, size_t arista);
+        void Completar_arbol();
+        void Calcular_potenciales();
+        bool Buscar_entrante(size_t& i, size_t& j);
+        void Pivotear(size_t i, size_t j);
+        void Reemplazar_arista(size_t e, size_t i, size_t j);
+        void Agregar_ficticio(bool es_fila);
+        void Marcar_lado(size_t e, std::vector<char>& lado);
+        long long Menor_reducido(const std::vector<char>& lado, bool filas_del_lado, size_t excluir_i, size_t excluir_j,
+                                 bool parar_en_cero, size_t* mejor_i = nullptr, size_t* mejor_j = nullptr);
+
+        public:
+        Transporte(const Problema& problema);
+        bool Valido() const;
+        void Esquina_noroeste();
+        void Costo_minimo();
+        void Vogel();
+        void Cargar_base(const std::vector<Asignacion>& base);
+        void Cargar_asignaciones(const std::vector<Asignacion>& asignaciones);
+        bool Recalcular_flujos();
+        bool Reparar(size_t max_pivotes);
+        bool Cambiar_cantidades(const std::vector<long long>& oferta, const std::vector<long long>& demanda);
+        void Cambiar_costos(const int* costos);
+        bool Optimizar(size_t max_pivotes);
+        long long Costo_total() const;
+        size_t Pivotes() const { return pivotes; }
+        Solucion Resultado() const;
+        std::vector<Rango_costo> Rangos_costo(const std::vector<std::pair<size_t, size_t>>& celdas);
+    };
+
+    Transporte::Transporte(const Problema& problema){
+        costos = problema.costos;
+        m = problema.oferta.size();
+        n = problema.demanda.size();
+        oferta = problema.oferta;
+        demanda = problema.demanda;
+
+        long long total_oferta = std::accumulate(oferta.begin(), oferta.end(), 0LL);
+        long long total_demanda = std::accumulate(demanda.begin(), demanda.end(), 0LL);
+        if(total_oferta > total_demanda)
+            demanda.push_back(total_oferta - total_demanda); // cliente ficticio
+        else if(total_demanda > total_oferta)
+            oferta.push_back(total_demanda - total_oferta);  // almacén ficticio
+
+        filas = oferta.size();
+        cols = demanda.size();
+        adyacentes.resize(filas + cols);
+        potencial.resize(filas + cols);
+        padre.resize(filas + cols);
+        profundidad.resize(filas + cols);
+    }
+
+    bool Transporte::Valido() const {
+        if(m == 0 || n == 0 || costos == nullptr)
+            return false;
+        for(long long o : oferta) if(o < 0) return false;
+        for(long long d : demanda) if(d < 0) return false;
+        return true;
+    }
+
+    void Transporte::Agregar_arista(size_t i, size_t j, long long cantidad){
+        arista_fila.push_back(i);
+        arista_col.push_back(j);
+        flujo.push_back(cantidad);
+    }
+
+    void Transporte::Quitar_adyacencia(size_t nodo, size_t arista){
+        auto& lista = adyacentes[nodo];
+        for(size_t k = 0; k < lista.size(); k++){
+            if(lista[k] == arista){
+                lista[k] = lista.back();
+                lista.pop_back();
+                return;
+            }
+        }
+    }
+
+    /**
+     * Las soluciones iniciales cruzan una sola línea por asignación, lo que
+     * produce filas + columnas - 1 celdas formando un árbol. Por si la base
+     * llegó incompleta o con ciclos (p. ej. desde un archivo), se descartan las
+     * celdas que cierran un ciclo y se unen las componentes sueltas con celdas
+     * degeneradas de flujo 0. Al final se arman las listas de adyacencia.
+     */
+    void Transporte::Completar_arbol(){
+        std::vector<size_t> grupo(filas + cols);
+        std::iota(grupo.begin(), grupo.end(), 0);
+        auto raiz = [&](size_t x){
+            while(grupo[x] != x){
+                grupo[x] = grupo[grupo[x]];
+                x = grupo[x];
+            }
+            return x;
+        };
+
+        size_t conservadas = 0;
+        for(size_t e = 0; e < flujo.size(); e++){
+            size_t a = raiz(arista_fila[e]), b = raiz(filas + arista_col[e]);
+            if(a == b)
+                continue;
+            grupo[a] = b;
+            arista_fila[conservadas] = arista_fila[e];
+            arista_col[conservadas] = arista_col[e];
+            flujo[conservadas] = flujo[e];
+            conservadas++;
+        }
+        arista_fila.resize(conservadas);
+        arista_col.resize(conservadas);
+        flujo.resize(conservadas);
+
+        for(size_t i = 0; i < filas && flujo.size() < filas + cols - 1; i++){
+            for(size_t j = 0; j < cols && flujo.size() < filas + cols - 1; j++){
+                size_t a = raiz(i), b = raiz(filas + j);
+                if(a != b){
+                    grupo[a] = b;
+                    Agregar_arista(i, j, 0);
+                }
+            }
+        }
+
+        for(auto& lista : adyacentes) lista.clear();
+        for(size_t e = 0; e < flujo.size(); e++){
+            adyacentes[arista_fila[e]].push_back(e);
+            adyacentes[filas + arista_col[e]].push_back(e);
+        }
+    }
+
+    void Transporte::Esquina_noroeste(){
+        std::vector<long long> o = oferta, d = demanda;
+        size_t i = 0, j = 0;
+        while(i < filas && j < cols){
+            long long cantidad = std::min(o[i], d[j]);
+            Agregar_arista(i, j, cantidad);
+            o[i] -= cantidad;
+            d[j] -= cantidad;
+            // Si se agotan ambas se cruza solo la fila (celda degenerada después)
+            if(o[i] == 0 && i + 1 < filas)
+                i++;
+            else
+                j++;
+        }
+        Completar_arbol();
+    }
+
+    void Transporte::Costo_minimo(){
+        std::vector<long long> o = oferta, d = demanda;
+        size_t celdas = filas * cols;
+
+        // Llave de 64 bits: costo desplazado en la parte alta y el índice en la baja.
+        // Ordenar enteros planos evita la indirección de comparar a través de la matriz.
+        long long minimo = 0;
+        for(size_t k = 0; k < m * n; k++) minimo = std::min<long long>(minimo, costos[k]);
+        std::vector<uint64_t> orden(celdas);
+        for(size_t i = 0; i < filas; i++)
+            for(size_t j = 0; j < cols; j++){
+                uint64_t costo = (uint64_t)(Costo(i, j) - minimo);
+                orden[i * cols + j] = (costo << 32) | (uint64_t)(i * cols + j);
+            }
+        std::sort(orden.begin(), orden.end());
+
+        std::vector<bool> fila_cruzada(filas, false), col_cruzada(cols, false);
+        size_t filas_activas = filas;
+        for(uint64_t llave : orden){
+            size_t k = (size_t)(llave & 0xFFFFFFFFu);
+            size_t i = k / cols, j = k % cols;
+            if(fila_cruzada[i] || col_cruzada[j])
+                continue;
+            long long cantidad = std::min(o[i], d[j]);
+            Agregar_arista(i, j, cantidad);
+            o[i] -= cantidad;
+            d[j] -= cantidad;
+            if(o[i] == 0 && filas_activas > 1){
+                fila_cruzada[i] = true;
+                filas_activas--;
+            }
+            else{
+                col_cruzada[j] = true;
+            }
+            if(flujo.size() == filas + cols - 1)
+                break;
+        }
+        Completar_arbol();
+    }
+
+    /**
+     * Aproximación de Vogel. Para cada línea se guardan las dos celdas más
+     * baratas entre las líneas activas; solo se vuelven a buscar cuando se cruza
+     * una de ellas. Las líneas activas se llevan en listas compactas para que
+     * cada búsqueda recorra únicamente lo que sigue vivo.
+     */
+    void Transporte::Vogel(){
+        std::vector<long long> o = oferta, d = demanda;
+        std::vector<size_t> fila_min1(filas), fila_min2(filas), col_min1(cols), col_min2(cols);
+
+        // Listas de líneas activas con su posición para quitarlas en O(1)
+        std::vector<size_t> filas_vivas(filas), cols_vivas(cols);
+        std::vector<size_t> pos_fila(filas), pos_col(cols);
+        std::iota(filas_vivas.begin(), filas_vivas.end(), 0);
+        std::iota(cols_vivas.begin(), cols_vivas.end(), 0);
+        std::iota(pos_fila.begin(), pos_fila.end(), 0);
+        std::iota(pos_col.begin(), pos_col.end(), 0);
+        auto quitar = [](std::vector<size_t>& vivas, std::vector<size_t>& pos, size_t x){
+            size_t ultimo = vivas.back();
+            vivas[pos[x]] = ultimo;
+            pos[ultimo] = pos[x];
+            vivas.pop_back();
+        };
+
+        auto buscar_fila = [&](size_t i){
+            size_t a = NINGUNO, b = NINGUNO;
+            for(size_t j : cols_vivas){
+                if(a == NINGUNO || Costo(i, j) < Costo(i, a)){ b = a; a = j; }
+                else if(b == NINGUNO || Costo(i, j) < Costo(i, b)){ b = j; }
+            }
+            fila_min1[i] = a;
+            fila_min2[i] = b;
+        };
+        auto buscar_col = [&](size_t j){
+            size_t a = NINGUNO, b = NINGUNO;
+            for(size_t i : filas_vivas){
+                if(a == NINGUNO || Costo(i, j) < Costo(a, j)){ b = a; a = i; }
+                else if(b == NINGUNO || Costo(i, j) < Costo(b, j)){ b = i; }
+            }
+            col_min1[j] = a;
+            col_min2[j] = b;
+        };
+        for(size_t i = 0; i < filas; i++) buscar_fila(i);
+        for(size_t j = 0; j < cols; j++) buscar_col(j);
+
+        while(!filas_vivas.empty() && !cols_vivas.empty()){
+            // Línea con la mayor penalización; empates por el menor costo. Con
+            // costos negativos la penalización de una línea con una sola opción
+            // (su costo) puede ser negativa, así que se parte del mínimo posible.
+            long long mejor_pen = std::numeric_limits<long long>::min(), mejor_costo = 0;
+            size_t mi = NINGUNO, mj = NINGUNO;
+            for(size_t i : filas_vivas){
+                long long c1 = Costo(i, fila_min1[i]);
+                long long pen = (fila_min2[i] == NINGUNO) ? c1 : Costo(i, fila_min2[i]) - c1;
+                if(pen > mejor_pen || (pen == mejor_pen && c1 < mejor_costo)){
+                    mejor_pen = pen; mejor_costo = c1; mi = i; mj = fila_min1[i];
+                }
+            }
+            for(size_t j : cols_vivas){
+                long long c1 = Costo(col_min1[j], j);
+                long long pen = (col_min2[j] == NINGUNO) ? c1 : Costo(col_min2[j], j) - c1;
+                if(pen > mejor_pen || (pen == mejor_pen && c1 < mejor_costo)){
+                    mejor_pen = pen; mejor_costo = c1; mi = col_min1[j]; mj = j;
+                }
+            }
+
+            long long cantidad = std::min(o[mi], d[mj]);
+            Agregar_arista(mi, mj, cantidad);
+            o[mi] -= cantidad;
+            d[mj] -= cantidad;
+
+            // Si se agotan ambas se cruza solo la fila (celda degenerada después)
+            if(o[mi] == 0 && filas_vivas.size() > 1){
+                quitar(filas_vivas, pos_fila, mi);
+                for(size_t j : cols_vivas)
+                    if(col_min1[j] == mi || col_min2[j] == mi)
+                        buscar_col(j);
+            }
+            else{
+                quitar(cols_vivas, pos_col, mj);
+                for(size_t i : filas_vivas)
+                    if(fila_min1[i] == mj || fila_min2[i] == mj)
+                        buscar_fila(i);
+            }
+        }
+        Completar_arbol();
+    }
+
+    void Transporte::Cargar_base(const std::vector<Asignacion>& base){
+        for(const auto& celda : base)
+            if(celda.almacen < filas && celda.cliente < cols)
+                Agregar_arista(celda.almacen, celda.cliente, celda.cantidad);
+        Completar_arbol();
+    }
+
+    /**
+     * Como Cargar_base, pero acepta también una base parcial, p. ej. solo las
+     * celdas reales con envío (lo que se guarda en "resultados"): lo que le
+     * falta a cada línea se asigna al almacén o cliente ficticio para que la
+     * base vuelva a cubrir todo. Si la base trae celdas de un ficticio que
+     * este problema no necesita (quedó con cantidad 0 al reoptimizar), se
+     * agrega con cantidad 0 para conservar el árbol completo.
+     */
+    void Transporte::Cargar_asignaciones(const std::vector<Asignacion>& asignaciones){
+        for(const auto& celda : asignaciones){
+            if(celda.almacen == m && filas == m) Agregar_ficticio(true);
+            if(celda.cliente == n && cols == n) Agregar_ficticio(false);
+        }
+        std::vector<Asignacion> base = asignaciones;
+        if(filas > m || cols > n){
+            std::vector<long long> enviado(filas, 0), recibido(cols, 0);
+            for(const auto& celda : asignaciones){
+                if(celda.almacen < filas && celda.cliente < cols){
+                    enviado[celda.almacen] += celda.cantidad;
+                    recibido[celda.cliente] += celda.cantidad;
+                }
+            }
+            if(cols > n)
+                for(size_t i = 0; i < m; i++)
+                    if(oferta[i] > enviado[i]) base.push_back(Asignacion{i, n, oferta[i] - enviado[i]});
+            if(filas > m)
+                for(size_t j = 0; j < n; j++)
+                    if(demanda[j] > recibido[j]) base.push_back(Asignacion{m, j, demanda[j] - recibido[j]});
+        }
+        Cargar_base(base);
+    }
+
+    /**
+     * Con la base fija, los flujos quedan determinados por la oferta y la
+     * demanda: se resuelven desde las hojas del árbol hacia la raíz.
+     * Devuelve false si alguno queda negativo (la base no es factible).
+     */
+    bool Transporte::Recalcular_flujos(){
+        Calcular_potenciales();
+        std::vector<long long> resto(filas + cols);
+        for(size_t i = 0; i < filas; i++) resto[i] = oferta[i];
+        for(size_t j = 0; j < cols; j++) resto[filas + j] = -demanda[j];
+
+        bool factible = true;
+        for(size_t k = orden.size(); k-- > 1;){   // orden[0] es la raíz
+            size_t nodo = orden[k];
+            size_t e = padre[nodo];
+            if(nodo < filas){
+                flujo[e] = resto[nodo];
+                resto[filas + arista_col[e]] += flujo[e];
+            }
+            else{
+                flujo[e] = -resto[nodo];
+                resto[arista_fila[e]] -= flujo[e];
+            }
+            factible = factible && flujo[e] >= 0;
+        }
+        return factible;
+    }
+
+    // La celda (i, j) toma el lugar de la arista e en el árbol
+    void Transporte::Reemplazar_arista(size_t e, size_t i, size_t j){
+        Quitar_adyacencia(arista_fila[e], e);
+        Quitar_adyacencia(filas + arista_col[e], e);
+        arista_fila[e] = i;
+        arista_col[e] = j;
+        adyacentes[i].push_back(e);
+        adyacentes[filas + j].push_back(e);
+    }
+
+    /**
+     * Agrega el almacén (es_fila) o el cliente ficticio con cantidad 0. Si ya
+     * hay una base, entra a ella con una celda degenerada junto a la columna
+     * (o fila) de mayor potencial: así ningún costo reducido del ficticio
+     * queda negativo y una base óptima lo sigue siendo.
+     */
+    void Transporte::Agregar_ficticio(bool es_fila){
+        size_t enlace = 0;
+        if(!flujo.empty()){
+            Calcular_potenciales();
+            size_t inicio = es_fila ? filas : 0, fin = es_fila ? filas + cols : filas;
+            for(size_t x = inicio; x < fin; x++)
+                if(potencial[x] > potencial[inicio + enlace]) enlace = x - inicio;
+        }
+        if(es_fila){
+            oferta.push_back(0);
+            filas++;
+        }
+        else{
+            demanda.push_back(0);
+            cols++;
+        }
+        adyacentes.resize(filas + cols);
+        potencial.resize(filas + cols);
+        padre.resize(filas + cols);
+        profundidad.resize(filas + cols);
+        if(flujo.empty())
+            return;
+
+        if(es_fila) Agregar_arista(filas - 1, enlace, 0);
+        else        Agregar_arista(enlace, cols - 1, 0);
+        // Los nodos de las columnas se recorren al agregar una fila: se rehacen las listas
+        for(auto& lista : adyacentes) lista.clear();
+        for(size_t e = 0; e < flujo.size(); e++){
+            adyacentes[arista_fila[e]].push_back(e);
+            adyacentes[filas + arista_col[e]].push_back(e);
+        }
+    }
+
+    // lado[nodo] = 1 para los nodos que quedan del lado de la fila de e al quitarla
+    void Transporte::Marcar_lado(size_t e, std::vector<char>& lado){
+        lado.assign(filas + cols, 0);
+        pila.clear();
+        pila.push_back(arista_fila[e]);
+        lado[arista_fila[e]] = 1;
+        while(!pila.empty()){
+            size_t nodo = pila.back();
+            pila.pop_back();
+            for(size_t a : adyacentes[nodo]){
+                if(a == e) continue;
+                size_t otro = (nodo == arista_fila[a]) ? filas + arista_col[a] : arista_fila[a];
+                if(!lado[otro]){
+                    lado[otro] = 1;
+                    pila.push_back(otro);
+                }
+            }
+        }
+    }
+
+    /**
+     * Menor costo reducido entre las celdas que cruzan de un lado al otro:
+     * filas del lado marcado y columnas del otro (filas_del_lado) o al revés.
+     * SIN_LIMITE si no hay ninguna. Requiere los potenciales al día. Con
+     * parar_en_cero la búsqueda termina al encontrar un 0, que ya es el
+     * menor posible si la base es óptima (ningún reducido es negativo).
+     */
+    long long Transporte::Menor_reducido(const std::vector<char>& lado, bool filas_del_lado, size_t excluir_i, size_t excluir_j,
+                                         bool parar_en_cero, size_t* mejor_i, size_t* mejor_j){
+        std::vector<size_t> fs, cs;
+        for(size_t i = 0; i < filas; i++) if((bool)lado[i] == filas_del_lado) fs.push_back(i);
+        for(size_t j = 0; j < cols; j++) if((bool)lado[filas + j] != filas_del_lado) cs.push_back(j);
+
+        // Los v de las columnas del otro lado quedan contiguos; la columna
+        // ficticia (si está) es la última y tiene costo 0
+        std::vector<long long> v(cs.size());
+        for(size_t k = 0; k < cs.size(); k++) v[k] = potencial[filas + cs[k]];
+        size_t reales = (!cs.empty() && cs.back() >= n) ? cs.size() - 1 : cs.size();
+
+        long long mejor = SIN_LIMITE;
+        auto probar = [&](long long reducido, size_t i, size_t j){
+            if(reducido < mejor && !(i == excluir_i && j == excluir_j)){
+                mejor = reducido;
+                if(mejor_i) *mejor_i = i;
+                if(mejor_j) *mejor_j = j;
+            }
+        };
+        for(size_t i : fs){
+            long long u = potencial[i];
+            if(i >= m){
+                for(size_t k = 0; k < cs.size(); k++) probar(-u - v[k], i, cs[k]);
+                continue;
+            }
+            const int* fila = costos + i * n;
+            for(size_t k = 0; k < reales; k++){
+                long long reducido = fila[cs[k]] - u - v[k];
+                if(reducido < mejor) probar(reducido, i, cs[k]);
+            }
+            if(reales < cs.size()) probar(-u - v[reales], i, cs[reales]);
+            if(mejor <= 0 && parar_en_cero)
+                break;
+        }
+        return mejor;
+    }
+
+    /**
+     * Corrige los flujos negativos con pivotes duales: sale la celda más
+     * negativa y entra, entre las que reconectan los dos pedazos del árbol en
+     * el sentido que falta, la de menor costo reducido. Si la base era óptima
+     * para los costos actuales lo sigue siendo al terminar. Devuelve false si
+     * no lo logra en max_pivotes.
+     */
+    bool Transporte::Reparar(size_t max_pivotes){
+        std::vector<char> lado;
+        size_t hechos = 0;
+        while(true){
+            size_t sale = NINGUNO;
+            long long peor = 0;
+            for(size_t e = 0; e < flujo.size(); e++){
+                if(flujo[e] < peor){
+                    peor = flujo[e];
+                    sale = e;
+                }
+            }
+            if(sale == NINGUNO)
+                return true;
+            if(hechos == max_pivotes)
+                return false;
+
+            // El lado de la fila manda de menos: le tiene que llegar de una fila del otro lado
+            Marcar_lado(sale, lado);
+            size_t ei = NINGUNO, ej = NINGUNO;
+            Menor_reducido(lado, false, NINGUNO, NINGUNO, true, &ei, &ej);
+            if(ei == NINGUNO)
+                return false;
+            Reemplazar_arista(sale, ei, ej);
+            hechos++;
+            reparaciones++;
+            Recalcular_flujos();
+        }
+    }
+
+    /**
+     * Cambia oferta y demanda conservando la base. Si ahora hace falta un
+     * ficticio que no había se agrega; uno que ya no hace falta se queda con
+     * cantidad 0. Devuelve false si cambian las dimensiones.
+     */
+    bool Transporte::Cambiar_cantidades(const std::vector<long long>& nueva_oferta, const std::vector<long long>& nueva_demanda){
+        if(nueva_oferta.size() != m || nueva_demanda.size() != n)
+            return false;
+        long long total_oferta = std::accumulate(nueva_oferta.begin(), nueva_oferta.end(), 0LL);
+        long long total_demanda = std::accumulate(nueva_demanda.begin(), nueva_demanda.end(), 0LL);
+        if(total_demanda > total_oferta && filas == m)
+            Agregar_ficticio(true);
+        if(total_oferta > total_demanda && cols == n)
+            Agregar_ficticio(false);
+
+        std::copy(nueva_oferta.begin(), nueva_oferta.end(), oferta.begin());
+        std::copy(nueva_demanda.begin(), nueva_demanda.end(), demanda.begin());
+        if(filas > m) oferta[m] = std::max(0LL, total_demanda - total_oferta);
+        if(cols > n) demanda[n] = std::max(0LL, total_oferta - total_demanda);
+        return true;
+    }
+
+    void Transporte::Cambiar_costos(const int* nuevos){
+        costos = nuevos;
+        siguiente_bloque = 0;
+    }
+
+    /**
+     * Recorre el árbol de la base desde la fila 0 fijando u0 = 0 y
+     * ui + vj = cij en cada celda básica. De paso guarda padre y profundidad
+     * para localizar el ciclo del pivote.
+     */
+    void Transporte::Calcular_potenciales(){
+        std::fill(padre.begin(), padre.end(), NINGUNO);
+        pila.clear();
+        orden.clear();
+        pila.push_back(0);
+        potencial[0] = 0;
+        profundidad[0] = 0;
+        while(!pila.empty()){
+            size_t nodo = pila.back();
+            pila.pop_back();
+            orden.push_back(nodo);
+            for(size_t e : adyacentes[nodo]){
+                if(e == padre[nodo]) continue;
+                size_t i = arista_fila[e], j = arista_col[e];
+                size_t otro = (nodo == i) ? filas + j : i;
+                padre[otro] = e;
+                profundidad[otro] = profundidad[nodo] + 1;
+                potencial[otro] = Costo(i, j) - potencial[nodo];
+                pila.push_back(otro);
+            }
+        }
+    }
+
+    /**
+     * Precio por bloques: se revisan las celdas en bloques de ~sqrt(filas*cols)
+     * a partir de donde terminó la búsqueda anterior y se toma la celda con el
+     * costo reducido más negativo del primer bloque que tenga alguna.
+     */
+    bool Transporte::Buscar_entrante(size_t& ei, size_t& ej){
+        size_t celdas = filas * cols;
+        size_t bloque = std::max<size_t>(64, (size_t)std::sqrt((double)celdas));
+        long long mejor = 0;
+        size_t revisadas = 0, k = siguiente_bloque;
+        while(revisadas < celdas){
+            size_t fin = std::min(revisadas + bloque, celdas);
+            for(; revisadas < fin; revisadas++){
+                size_t i = k / cols, j = k % cols;
+                long long reducido = Costo(i, j) - potencial[i] - potencial[filas + j];
+                if(reducido < mejor){
+                    mejor = reducido;
+                    ei = i;
+                    ej = j;
+                }
+                if(++k == celdas) k = 0;
+            }
+            if(mejor < 0){
+                siguiente_bloque = k;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Transporte::Pivotear(size_t ei, size_t ej){
+        // Caminos desde cada extremo de la celda entrante hasta el ancestro común
+        std::vector<size_t> lado_fila, lado_col;
+        size_t a = ei, b = filas + ej;
+        while(a != b){
+            if(profundidad[a] >= profundidad[b]){
+                size_t e = padre[a];
+                lado_fila.push_back(e);
+                a = (arista_fila[e] == a) ? filas + arista_col[e] : arista_fila[e];
+            }
+            else{
+                size_t e = padre[b];
+                lado_col.push_back(e);
+                b = (arista_fila[e] == b) ? filas + arista_col[e] : arista_fila[e];
+            }
+        }
+
+        // En cada lado los signos alternan empezando en '-' junto a la celda entrante.
+        // Ante empates se elige la última celda bloqueante recorriendo el ciclo
+        // desde el ancestro en el sentido de la celda entrante.
+        long long theta = std::numeric_limits<long long>::max();
+        for(size_t k = 0; k < lado_fila.size(); k += 2) theta = std::min(theta, flujo[lado_fila[k]]);
+        for(size_t k = 0; k < lado_col.size(); k += 2) theta = std::min(theta, flujo[lado_col[k]]);
+
+        size_t sale = NINGUNO;
+        for(size_t k = lado_col.size(); k-- > 0;)
+            if(k % 2 == 0 && flujo[lado_col[k]] == theta){ sale = lado_col[k]; break; }
+        if(sale == NINGUNO)
+            for(size_t k = 0; k < lado_fila.size(); k += 2)
+                if(flujo[lado_fila[k]] == theta){ sale = lado_fila[k]; break; }
+
+        for(size_t k = 0; k < lado_fila.size(); k++)
+            flujo[lado_fila[k]] += (k % 2 == 0) ? -theta : theta;
+        for(size_t k = 0; k < lado_col.size(); k++)
+            flujo[lado_col[k]] += (k % 2 == 0) ? -theta : theta;
+
+        // La celda entrante ocupa el lugar de la que sale
+        Quitar_adyacencia(arista_fila[sale], sale);
+        Quitar_adyacencia(filas + arista_col[sale], sale);
+        arista_fila[sale] = ei;
+        arista_col[sale] = ej;
+        flujo[sale] = theta;
+        adyacentes[ei].push_back(sale);
+        adyacentes[filas + ej].push_back(sale);
+        pivotes++;
+    }
+
+    bool Transporte::Optimizar(size_t max_pivotes){
+        size_t i = 0, j = 0;
+        while(pivotes < max_pivotes){
+            Calcular_potenciales();
+            if(!Buscar_entrante(i, j))
+                return true;
+            Pivotear(i, j);
+        }
+        return false;
+    }
+
+    long long Transporte::Costo_total() const {
+        long long total = 0;
+        for(size_t e = 0; e < flujo.size(); e++)
+            total += flujo[e] * Costo(arista_fila[e], arista_col[e]);
+        return total;
+    }
+
+    Solucion Transporte::Resultado() const {
+        Solucion solucion;
+        solucion.filas = filas;
+        solucion.columnas = cols;
+        solucion.base.reserve(flujo.size());
+        for(size_t e = 0; e < flujo.size(); e++)
+            solucion.base.push_back(Asignacion{arista_fila[e], arista_col[e], flujo[e]});
+        solucion.costo_total = Costo_total();
+        solucion.pivotes = pivotes;
+        solucion.pivotes_reparacion = reparaciones;
+        return solucion;
+    }
+
+    /**
+     * Rangos de costo de las celdas pedidas (índices base 0) con la base
+     * actual, que se supone óptima.
+     *   - no básica: [costo - reducido, sin límite)
+     *   - básica: al quitarla el árbol se parte en dos; si su costo sube lo
+     *     limita la celda más barata (en costo reducido) que podría reemplazarla,
+     *     y si baja, la más barata de las que cruzan en sentido contrario.
+     */
+    std::vector<Rango_costo> Transporte::Rangos_costo(const std::vector<std::pair<size_t, size_t>>& celdas){
+        Calcular_potenciales();
+        std::unordered_map<size_t, size_t> basicas;
+        for(size_t e = 0; e < flujo.size(); e++)
+            basicas[arista_fila[e] * cols + arista_col[e]] = e;
+
+        std::vector<Rango_costo> rangos;
+        std::vector<char> lado;
+        for(const auto& [i, j] : celdas){
+            if(i >= filas || j >= cols)
+                continue;
+            Rango_costo rango{ i, j, Costo(i, j), false, 0, 0, 0, SIN_LIMITE };
+            auto basica = basicas.find(i * cols + j);
+            if(basica == basicas.end()){
+                rango.reducido = Costo(i, j) - potencial[i] - potencial[filas + j];
+                rango.minimo = rango.costo - rango.reducido;
+            }
+            else{
+                size_t e = basica->second;
+                rango.basica = true;
+                rango.cantidad = flujo[e];
+                Marcar_lado(e, lado);
+                long long sube = Menor_reducido(lado, true, i, j, true);
+                long long baja = Menor_reducido(lado, false, i, j, true);
+                rango.maximo = (sube == SIN_LIMITE) ? SIN_LIMITE : rango.costo + sube;
+                rango.minimo = (baja == SIN_LIMITE) ? -SIN_LIMITE : rango.costo - baja;
+            }
+            rangos.push_back(rango);
+        }
+        return rangos;
+    }
+
+    /**
+     * Construye la solución inicial con el método pedido y, si se indica,
+     * la lleva al óptimo con MODI. Devuelve false si el problema no es válido.
+     */
+    static bool Resolver_modelo(Transporte& modelo, const Opciones& opciones, Solucion& solucion){
+        if(!modelo.Valido()){
+            std::cerr << "Problema de transporte inválido (dimensiones o cantidades negativas).\n";
+            return false;
+        }
+        switch(opciones.metodo){
+            case Metodo::Esquina_noroeste: modelo.Esquina_noroeste(); break;
+            case Metodo::Costo_minimo:     modelo.Costo_minimo();     break;
+            case Metodo::Vogel:            modelo.Vogel();            break;
+        }
+        long long costo_inicial = modelo.Costo_total();
+        bool optima = opciones.optimizar ? modelo.Optimizar(opciones.max_pivotes) : false;
+        solucion = modelo.Resultado();
+        solucion.costo_inicial = costo_inicial;
+        solucion.optima = optima;
+        return true;
+    }
+
+    bool Resolver(const Problema& problema, const Opciones& opciones, Solucion& solucion){
+        Transporte modelo(problema);
+        return Resolver_modelo(modelo, opciones, solucion);
+    }
+
+    /**
+     * Vuelve a resolver partiendo de la solución obtenida para "anterior" en
+     * lugar de empezar de cero. "asignaciones" puede ser su base completa
+     * (Solucion::base) o solo las celdas con envío, índices base 0; con la
+     * base completa el paso 1 no necesita pivotes.
+     *
+     *   1. la base se arma con esas asignaciones y se lleva al óptimo con los
+     *      datos anteriores (si ya lo era, sin pivotes);
+     *   2. se cambian oferta y demanda; los flujos se recalculan sobre el
+     *      mismo árbol y los negativos se corrigen con pivotes duales;
+     *   3. se cambian los costos y MODI sigue desde esa base.
+     * Si cambiaron las dimensiones o la base anterior no sirve, se resuelve
+     * desde cero con opciones.metodo. Un cambio de balance no cuenta: el
+     * ficticio que haga falta se agrega a la base. Al final se calculan los rangos de
+     * costo de "celdas".
+     */
+    bool Reoptimizar(const Problema& anterior,
+                     const std::vector<Asignacion>& asignaciones,
+                     const Problema& problema,
+                     const Opciones& opciones,
+                     const std::vector<std::pair<size_t, size_t>>& celdas,
+                     Solucion& solucion,
+                     std::vector<Rango_costo>& rangos){
+        Transporte modelo(anterior);
+        bool caliente = modelo.Valido()
+            && anterior.oferta.size() == problema.oferta.size()
+            && anterior.demanda.size() == problema.demanda.size();
+        if(caliente){
+            modelo.Cargar_asignaciones(asignaciones);
+            caliente = modelo.Recalcular_flujos() && modelo.Optimizar(opciones.max_pivotes);
+        }
+        size_t pivotes_previos = modelo.Pivotes();
+        caliente = caliente && modelo.Cambiar_cantidades(problema.oferta, problema.demanda) && modelo.Valido();
+        if(caliente && !modelo.Recalcular_flujos()){
+            size_t lineas = problema.oferta.size() + problema.demanda.size();
+            caliente = modelo.Reparar(10 * lineas);
+        }
+
+        if(!caliente){
+            Transporte desde_cero(problema);
+            if(!Resolver_modelo(desde_cero, opciones, solucion))
+                return false;
+            rangos = desde_cero.Rangos_costo(celdas);
+            return true;
+        }
+
+        modelo.Cambiar_costos(problema.costos);
+        long long costo_inicial = modelo.Costo_total();
+        size_t limite = pivotes_previos + std::min(opciones.max_pivotes, SIZE_MAX - pivotes_previos);
+        bool optima = modelo.Optimizar(limite);
+        solucion = modelo.Resultado();
+        solucion.costo_inicial = costo_inicial;
+        solucion.optima = optima;
+        solucion.en_caliente = true;
+        rangos = modelo.Rangos_costo(celdas);
+        return true;
+    }
+}
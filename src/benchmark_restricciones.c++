@@ -0,0 +1,213 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "parser.cpp"
+#include "restricciones.cpp"
+#include "simplex.cpp"
+
+/////////////////////////////////////////////////////////////////////
+// Benchmark de los kernels de factibilidad.                        //
+//                                                                   //
+// Genera m restricciones aleatorias y un lote de puntos, y mide     //
+// cuánto tarda cada forma de revisar todos los puntos contra todas  //
+// las restricciones:                                                //
+//   - punteros a PSR::Ecuation con getters y un switch por operador //
+//     (como se hacía al achurar y filtrar vértices)                 //
+//   - la tabla RST con el kernel escalar, SSE2 y AVX2, un punto a   //
+//     la vez y por lotes (RST::Factibles)                           //
+// Las restricciones se generan de modo que casi todos los puntos    //
+// cumplan la mayoría, así cada revisión recorre la tabla completa.  //
+// Antes de medir revisa que SPX rechace cotas con l > u, tanto al  //
+// leer un modelo como al armarlo por código.                        //
+//                                                                   //
+// Uso: ./benchmark_restricciones [m1 m2 ...]                        //
+/////////////////////////////////////////////////////////////////////
+
+using Reloj = std::chrono::steady_clock;
+
+static double Segundos(Reloj::time_point desde, Reloj::time_point hasta)
+{
+    return std::chrono::duration<double>(hasta - desde).count();
+}
+
+// Revisión anterior: una restricción a la vez a través de los getters
+static bool Factible_ecuaciones(std::vector<PSR::Ecuation*>& sistema, float x, float y)
+{
+    for(PSR::Ecuation* ecuacion : sistema){
+        float valor = ecuacion->get_x1() * x + ecuacion->get_x2() * y;
+        float c = ecuacion->get_result();
+        bool cumple;
+        switch(ecuacion->get_operator()){
+            case '<': cumple = valor <= c + 1e-4f; break;
+            case '>': cumple = valor >= c - 1e-4f; break;
+            case '=': cumple = std::abs(valor - c) <= 1e-4f; break;
+            default:  cumple = true; break;
+        }
+        if(!cumple)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * m restricciones "<" y ">" tangentes a círculos grandes alrededor del
+ * origen (todos los puntos del lote quedan dentro) y, si m > 8, una
+ * igualdad al final que solo cumplen algunos puntos.
+ */
+static void Generar(size_t m, unsigned semilla, RST::Tabla& tabla, std::vector<PSR::Ecuation*>& sistema)
+{
+    std::mt19937 gen(semilla);
+    std::uniform_real_distribution<float> angulo(0, 6.2831853f);
+    std::uniform_real_distribution<float> radio(100, 200);
+    tabla.Limpiar();
+    for(auto e : sistema) delete e;
+    sistema.clear();
+    for(size_t i = 0; i < m; i++){
+        float t = angulo(gen), r = radio(gen);
+        float a = std::cos(t), b = std::sin(t);
+        char op = (i % 2 == 0) ? '<' : '>';
+        if(op == '>'){ a = -a; b = -b; r = -r; }
+        if(m > 8 && i + 1 == m){ a = 1; b = -1; r = 0; op = '='; }
+        tabla.Agregar(a, b, op, r);
+        sistema.push_back(new PSR::Ecuation(a, b, r, op));
+    }
+}
+
+// Cotas invertidas: Leer_modelo las rechaza y el simplex declara el modelo infactible
+static int Verificar_cotas()
+{
+    int fallas = 0;
+    std::string archivo = "verificar_cotas.tmp";
+    {
+        std::ofstream salida(archivo);
+        salida << "max\n1 1 1\n1 1 1 < 10\ncota 1 5 2\n";
+    }
+    // El aviso de "cota inválida" es el esperado; se descarta
+    SPX::Modelo leido;
+    std::ostringstream avisos;
+    std::streambuf* anterior = std::cerr.rdbuf(avisos.rdbuf());
+    bool aceptado = SPX::Leer_modelo(archivo, leido);
+    std::cerr.rdbuf(anterior);
+    if(aceptado){
+        std::cout << "Leer_modelo aceptó cota 1 5 2\n";
+        fallas++;
+    }
+    std::remove(archivo.c_str());
+
+    SPX::Modelo modelo(3);
+    modelo.Fijar_sentido(SPX::Sentido::Maximizar);
+    for(size_t j = 0; j < 3; j++) modelo.Fijar_objetivo(j, 1.0);
+    modelo.Agregar_restriccion({1, 1, 1}, '<', 10);
+    modelo.Fijar_cota(0, 5, 2);
+    SPX::Resultado res = SPX::Resolver(modelo);
+    if(res.estado != SPX::Estado::Infactible){
+        std::cout << "cota 1 5 2 por código: se esperaba infactible y dio "
+                  << SPX::Nombre_estado(res.estado) << "\n";
+        fallas++;
+    }
+    return fallas;
+}
+
+int main(int argc, char* argv[])
+{
+    if(Verificar_cotas() > 0)
+        return 1;
+
+    std::vector<size_t> tamanos;
+    for(int i = 1; i < argc; i++)
+        tamanos.push_back(std::strtoul(argv[i], nullptr, 10));
+    if(tamanos.empty())
+        tamanos = {8, 64, 512, 4096, 32768};
+
+    // Puntos en [-50, 50]^2; uno de cada 8 sobre la recta x = y
+    const size_t puntos = 1 << 14;
+    std::vector<double> xs(puntos), ys(puntos);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> coordenada(-50, 50);
+    for(size_t k = 0; k < puntos; k++){
+        xs[k] = (float)coordenada(gen);
+        ys[k] = (k % 8 == 0) ? xs[k] : (float)coordenada(gen);
+    }
+
+    std::cout << "Kernel disponible: " << RST::Nombre_kernel(RST::Kernel_disponible()) << "\n";
+    std::cout << std::left << std::setw(8) << "m" << std::setw(12) << "ecuaciones"
+              << std::setw(12) << "escalar" << std::setw(12) << "sse2" << std::setw(12) << "avx2"
+              << std::setw(12) << "lote sse2" << std::setw(12) << "lote avx2"
+              << "mejora   (ns por punto y restricción; mejora = ecuaciones / mejor kernel)\n";
+
+    RST::Tabla tabla;
+    std::vector<PSR::Ecuation*> sistema;
+    int fallas = 0;
+    std::vector<uint8_t> factibles(puntos);
+    for(size_t m : tamanos){
+        Generar(m, 42 + (unsigned)m, tabla, sistema);
+        // Repeticiones para que cada medición dure algo medible
+        size_t repeticiones = std::max<size_t>(1, (1 << 24) / (m * puntos));
+        double operaciones = (double)repeticiones * puntos * m;
+
+        size_t referencia = 0;
+        auto t0 = Reloj::now();
+        for(size_t r = 0; r < repeticiones; r++){
+            referencia = 0;
+            for(size_t k = 0; k < puntos; k++)
+                referencia += Factible_ecuaciones(sistema, (float)xs[k], (float)ys[k]);
+        }
+        double ns_ecuaciones = Segundos(t0, Reloj::now()) * 1e9 / operaciones;
+        std::cout << std::setw(8) << m << std::setw(12) << std::setprecision(3) << ns_ecuaciones;
+
+        double mejor = ns_ecuaciones;
+        bool coinciden = true;
+        for(RST::Kernel k : {RST::Kernel::Escalar, RST::Kernel::SSE2, RST::Kernel::AVX2}){
+            RST::Funcion_factible funcion = RST::Funcion_kernel(k);
+            if(k != RST::Kernel::Escalar && funcion == RST::Factible_escalar){
+                std::cout << std::setw(12) << "-";
+                continue;
+            }
+            size_t total = 0;
+            auto t1 = Reloj::now();
+            for(size_t r = 0; r < repeticiones; r++){
+                total = 0;
+                for(size_t p = 0; p < puntos; p++){
+                    factibles[p] = funcion(tabla, xs[p], ys[p]);
+                    total += factibles[p];
+                }
+            }
+            double ns = Segundos(t1, Reloj::now()) * 1e9 / operaciones;
+            mejor = std::min(mejor, ns);
+            coinciden = coinciden && total == referencia;
+            std::cout << std::setw(12) << ns;
+        }
+
+        // Por lotes: además del conteo, cada punto debe coincidir con el kernel escalar
+        std::vector<uint8_t> esperados(puntos);
+        RST::Factibles_escalar(tabla, xs.data(), ys.data(), puntos, esperados.data());
+        for(RST::Kernel k : {RST::Kernel::SSE2, RST::Kernel::AVX2}){
+            RST::Funcion_factibles funcion = RST::Funcion_kernel_lote(k);
+            if(funcion == RST::Factibles_escalar){
+                std::cout << std::setw(12) << "-";
+                continue;
+            }
+            size_t total = 0;
+            auto t1 = Reloj::now();
+            for(size_t r = 0; r < repeticiones; r++)
+                total = funcion(tabla, xs.data(), ys.data(), puntos, factibles.data());
+            double ns = Segundos(t1, Reloj::now()) * 1e9 / operaciones;
+            mejor = std::min(mejor, ns);
+            coinciden = coinciden && total == referencia && factibles == esperados;
+            std::cout << std::setw(12) << ns;
+        }
+        std::cout << std::setprecision(2) << (mejor > 0 ? ns_ecuaciones / mejor : 0.0) << "x"
+                  << (coinciden ? "" : "  (¡los conteos de factibles no coinciden!)") << "\n";
+        fallas += !coinciden;
+    }
+    for(auto e : sistema) delete e;
+    return fallas > 0;
+}
@@ -0,0 +1,366 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////
+// Región factible de un sistema de 2 variables.                     //
+//                                                                    //
+// Cada restricción es un semiplano a·x + b·y <= c. La región es su    //
+// intersección (más x >= 0, y >= 0) y se obtiene en O(m log m):       //
+// se ordenan los semiplanos por ángulo y se recorren con una doble    //
+// cola. Para que la región quede acotada se agrega una caja de        //
+// trabajo mucho más grande que cualquier restricción; si el problema  //
+// es no acotado se sabe por el cono de direcciones de la región, no   //
+// por la caja.                                                       //
+//////////////////////////////////////////////////////////////////////
+
+namespace GEO {
+
+    const double EPS = 1e-9;
+
+    struct Punto {
+        double x, y;
+    };
+
+    // Semiplano a·x + b·y <= c
+    struct Semiplano {
+        double a, b, c;
+    };
+
+    static double Cruz(Punto u, Punto v){ return u.x * v.y - u.y * v.x; }
+    static double Punto_por(Punto u, Punto v){ return u.x * v.x + u.y * v.y; }
+    static Punto Resta(Punto u, Punto v){ return Punto{ u.x - v.x, u.y - v.y }; }
+
+    // Tolerancia relativa a la magnitud del punto que se evalúa
+    static double Tolerancia(Punto p){
+        return EPS * std::max(1.0, std::max(std::abs(p.x), std::abs(p.y)));
+    }
+
+    /**
+     * Agrega la restricción a·x + b·y {<,>,=} c como semiplanos "<=".
+     * Una igualdad da dos semiplanos. Devuelve false si el operador no es
+     * uno de <, > o =.
+     */
+    bool Agregar_restriccion(std::vector<Semiplano>& semiplanos, double a, double b, char op, double c){
+        switch(op){
+            case '<':
+                semiplanos.push_back(Semiplano{ a, b, c });
+                return true;
+            case '>':
+                semiplanos.push_back(Semiplano{ -a, -b, -c });
+                return true;
+            case '=':
+                semiplanos.push_back(Semiplano{ a, b, c });
+                semiplanos.push_back(Semiplano{ -a, -b, -c });
+                return true;
+        }
+        return false;
+    }
+
+    // true si el punto viola el semiplano (con tolerancia)
+    bool Fuera(const Semiplano& s, Punto p){
+        double norma = std::hypot(s.a, s.b);
+        if(norma == 0.0)
+            return s.c < -EPS;
+        return (s.a * p.x + s.b * p.y - s.c) / norma > Tolerancia(p);
+    }
+
+    // Recta de un semiplano normalizado: la región queda a la izquierda de d
+    struct Recta {
+        Punto p, d;
+        double angulo;
+    };
+
+    // Un punto indefinido (paralelas que quedaron juntas) cuenta como fuera
+    static bool Fuera(const Recta& r, Punto q){
+        return !(Cruz(r.d, Resta(q, r.p)) >= -Tolerancia(q));
+    }
+
+    static Punto Interseccion(const Recta& r, const Recta& s){
+        double t = Cruz(s.d, Resta(s.p, r.p)) / Cruz(s.d, r.d);
+        return Punto{ r.p.x + t * r.d.x, r.p.y + t * r.d.y };
+    }
+
+    /**
+     * Región contenida en la recta base (dos semiplanos opuestos que se
+     * tocan): se recorta el intervalo base.p + t·base.d con todas las
+     * rectas, en O(m). Devuelve los dos extremos, o nada si es vacío.
+     */
+    static std::vector<Punto> Intervalo_sobre_recta(const std::vector<Recta>& rectas, const Recta& base){
+        double t_min = -INFINITY, t_max = INFINITY;
+        for(const auto& r : rectas){
+            // cruz(r.d, base.p + t·base.d - r.p) >= -tol  ->  alfa + beta·t >= -tol
+            double alfa = Cruz(r.d, Resta(base.p, r.p));
+            double beta = Cruz(r.d, base.d);
+            double tol = Tolerancia(base.p);
+            if(std::abs(beta) < EPS){
+                if(alfa < -tol)
+                    return {};
+                continue;
+            }
+            double t = (-tol - alfa) / beta;
+            if(beta > 0) t_min = std::max(t_min, t);
+            else         t_max = std::min(t_max, t);
+        }
+        if(t_min > t_max || std::isinf(t_min) || std::isinf(t_max))
+            return {};
+        return {
+            Punto{ base.p.x + t_min * base.d.x, base.p.y + t_min * base.d.y },
+            Punto{ base.p.x + t_max * base.d.x, base.p.y + t_max * base.d.y }
+        };
+    }
+
+    /**
+     * Intersección de semiplanos en O(m log m). Los semiplanos deben
+     * acotar la región (la caja de trabajo lo asegura). Devuelve los
+     * vértices del polígono convexo en sentido antihorario, o nada si la
+     * intersección es vacía. Una región degenerada (segmento o punto)
+     * devuelve sus vértices repetidos, o solo los dos extremos si quedó
+     * sobre una recta por una igualdad.
+     */
+    std::vector<Punto> Interseccion(const std::vector<Semiplano>& semiplanos){
+        std::vector<Recta> rectas;
+        rectas.reserve(semiplanos.size());
+        for(const auto& s : semiplanos){
+            double norma = std::hypot(s.a, s.b);
+            if(norma < EPS){
+                if(s.c < -EPS)
+                    return {}; // 0 <= c no se cumple
+                continue;
+            }
+            Punto n{ s.a / norma, s.b / norma };
+            double c = s.c / norma;
+            Recta r;
+            r.p = Punto{ n.x * c, n.y * c };
+            r.d = Punto{ -n.y, n.x };
+            r.angulo = std::atan2(r.d.y, r.d.x);
+            // -pi y pi son la misma dirección (pasa con d.y = -0.0); deben quedar juntas al ordenar
+            if(r.angulo <= -M_PI + EPS)
+                r.angulo = M_PI;
+            rectas.push_back(r);
+        }
+        std::sort(rectas.begin(), rectas.end(), [](const Recta& r, const Recta& s){
+            return r.angulo < s.angulo;
+        });
+
+        // Doble cola sobre un arreglo: [ini, fin)
+        std::vector<Recta> cola(rectas.size());
+        size_t ini = 0, fin = 0;
+        for(const auto& r : rectas){
+            while(fin - ini > 1 && Fuera(r, Interseccion(cola[fin - 1], cola[fin - 2])))
+                fin--;
+            while(fin - ini > 1 && Fuera(r, Interseccion(cola[ini], cola[ini + 1])))
+                ini++;
+            if(fin - ini > 0 && std::abs(Cruz(r.d, cola[fin - 1].d)) < EPS){
+                // Paralelas opuestas que quedaron juntas: si se tocan la
+                // región está sobre esa recta, si no, no hay región
+                if(Punto_por(r.d, cola[fin - 1].d) < 0){
+                    double separacion = Cruz(cola[fin - 1].d, Resta(r.p, cola[fin - 1].p));
+                    if(std::abs(separacion) <= Tolerancia(r.p))
+                        return Intervalo_sobre_recta(rectas, r);
+                    return {};
+                }
+                // Misma dirección: se queda la más restrictiva
+                if(Fuera(r, cola[fin - 1].p))
+                    cola[fin - 1] = r;
+                continue;
+            }
+            cola[fin++] = r;
+        }
+        while(fin - ini > 2 && Fuera(cola[ini], Interseccion(cola[fin - 1], cola[fin - 2])))
+            fin--;
+        while(fin - ini > 2 && Fuera(cola[fin - 1], Interseccion(cola[ini], cola[ini + 1])))
+            ini++;
+        if(fin - ini < 3)
+            return {};
+
+        std::vector<Punto> vertices;
+        vertices.reserve(fin - ini);
+        Punto centro{ 0, 0 };
+        for(size_t i = ini; i < fin; i++){
+            const Recta& siguiente = (i + 1 < fin) ? cola[i + 1] : cola[ini];
+            vertices.push_back(Interseccion(cola[i], siguiente));
+            centro.x += vertices.back().x / (fin - ini);
+            centro.y += vertices.back().y / (fin - ini);
+        }
+
+        // Si la intersección es vacía la cola puede terminar con un polígono
+        // degenerado que no la representa; el centro de una región no vacía
+        // siempre está dentro, así que basta revisarlo contra todos, en O(m)
+        for(const auto& r : rectas){
+            if(Fuera(r, centro))
+                return {};
+        }
+        return vertices;
+    }
+
+    /**
+     * Recorta un polígono convexo con un semiplano (Sutherland-Hodgman de
+     * un solo lado), en O(k).
+     */
+    std::vector<Punto> Recortar(const std::vector<Punto>& poligono, const Semiplano& s){
+        std::vector<Punto> resultado;
+        size_t k = poligono.size();
+        for(size_t i = 0; i < k; i++){
+            Punto p = poligono[i];
+            Punto q = poligono[(i + 1) % k];
+            double vp = s.a * p.x + s.b * p.y - s.c;
+            double vq = s.a * q.x + s.b * q.y - s.c;
+            if(vp <= 0)
+                resultado.push_back(p);
+            if((vp < 0 && vq > 0) || (vp > 0 && vq < 0)){
+                double t = vp / (vp - vq);
+                resultado.push_back(Punto{ p.x + t * (q.x - p.x), p.y + t * (q.y - p.y) });
+            }
+        }
+        return resultado;
+    }
+
+    /**
+     * Recorta el segmento pq con un polígono convexo (Cyrus-Beck), en
+     * cualquier sentido de giro. Devuelve false si no queda nada.
+     */
+    bool Recortar_segmento(const std::vector<Punto>& poligono, Punto& p, Punto& q){
+        size_t k = poligono.size();
+        if(k < 3)
+            return false;
+        double area = 0;
+        for(size_t i = 0; i < k; i++)
+            area += Cruz(poligono[i], poligono[(i + 1) % k]);
+        double sentido = (area >= 0) ? 1.0 : -1.0;
+
+        Punto d = Resta(q, p);
+        double t0 = 0.0, t1 = 1.0;
+        for(size_t i = 0; i < k; i++){
+            Punto v = poligono[i];
+            Punto arista = Resta(poligono[(i + 1) % k], v);
+            // Dentro: sentido * cruz(arista, x - v) >= 0
+            double num = sentido * Cruz(arista, Resta(p, v));
+            double den = sentido * Cruz(arista, d);
+            if(std::abs(den) < EPS){
+                if(num < 0)
+                    return false;
+                continue;
+            }
+            double t = -num / den;
+            if(den > 0) t0 = std::max(t0, t);
+            else        t1 = std::min(t1, t);
+            if(t0 > t1)
+                return false;
+        }
+        Punto inicio{ p.x + t0 * d.x, p.y + t0 * d.y };
+        Punto final{ p.x + t1 * d.x, p.y + t1 * d.y };
+        p = inicio;
+        q = final;
+        return true;
+    }
+
+    /**
+     * Región factible: el polígono (recortado a la caja de trabajo) y el
+     * cono de direcciones en las que la región no está acotada, dado por
+     * sus dos rayos extremos.
+     */
+    struct Region {
+        std::vector<Semiplano> semiplanos;  // restricciones y no negatividad
+        std::vector<Punto> poligono;        // vacío si no es factible
+        bool hay_rayos = false;
+        Punto rayo_1{ 0, 0 }, rayo_2{ 0, 0 };
+    };
+
+    /**
+     * Cono {d >= 0 : a·d <= 0 para cada semiplano}. Empieza como el primer
+     * cuadrante y se recorta con cada semiplano; como el cono nunca abre
+     * más de 90 grados, un semiplano que deja fuera a los dos rayos lo
+     * deja vacío.
+     */
+    static void Calcular_rayos(Region& region){
+        Punto u{ 1, 0 }, v{ 0, 1 };
+        for(const auto& s : region.semiplanos){
+            double norma = std::hypot(s.a, s.b);
+            if(norma < EPS)
+                continue;
+            Punto n{ s.a / norma, s.b / norma };
+            bool fuera_u = Punto_por(n, u) > EPS;
+            bool fuera_v = Punto_por(n, v) > EPS;
+            if(fuera_u && fuera_v)
+                return;
+            if(!fuera_u && !fuera_v)
+                continue;
+            // Dirección de la frontera a·d = 0 que queda entre u y v
+            Punto frontera{ -n.y, n.x };
+            if(Cruz(u, frontera) < 0 || Cruz(frontera, v) < 0)
+                frontera = Punto{ n.y, -n.x };
+            if(fuera_u) u = frontera;
+            else        v = frontera;
+        }
+        region.hay_rayos = true;
+        region.rayo_1 = u;
+        region.rayo_2 = v;
+    }
+
+    Region Region_factible(const std::vector<Semiplano>& restricciones){
+        Region region;
+        region.semiplanos = restricciones;
+        region.semiplanos.push_back(Semiplano{ -1, 0, 0 }); // x >= 0
+        region.semiplanos.push_back(Semiplano{ 0, -1, 0 }); // y >= 0
+
+        // Caja de trabajo: un millón de veces la distancia de la recta más lejana al origen
+        double escala = 1.0;
+        for(const auto& s : restricciones){
+            double norma = std::hypot(s.a, s.b);
+            if(norma >= EPS)
+                escala = std::max(escala, std::abs(s.c) / norma);
+        }
+        double caja = escala * 1e6;
+        std::vector<Semiplano> todos = region.semiplanos;
+        todos.push_back(Semiplano{ 1, 0, caja });
+        todos.push_back(Semiplano{ 0, 1, caja });
+
+        region.poligono = Interseccion(todos);
+        if(!region.poligono.empty())
+            Calcular_rayos(region);
+        return region;
+    }
+
+    struct Optimo {
+        bool factible = false;
+        bool acotado = false;
+        Punto punto{ 0, 0 };
+        double valor = 0;
+    };
+
+    /**
+     * Óptimo de cx·x + cy·y sobre la región con un recorrido de sus
+     * vértices. Es no acotado si algún rayo del cono mejora el objetivo.
+     */
+    Optimo Optimizar(const Region& region, double cx, double cy, bool maximizar){
+        Optimo optimo;
+        if(region.poligono.empty())
+            return optimo;
+        optimo.factible = true;
+
+        double signo = maximizar ? 1.0 : -1.0;
+        Punto w{ signo * cx, signo * cy };
+        double tol = EPS * std::max(1.0, std::hypot(w.x, w.y));
+        if(region.hay_rayos && (Punto_por(w, region.rayo_1) > tol || Punto_por(w, region.rayo_2) > tol))
+            return optimo;
+        optimo.acotado = true;
+
+        // En un empate se prefiere el vértice más cercano al origen, para no
+        // tomar uno de la caja de trabajo
+        double mejor = -INFINITY;
+        for(const auto& p : region.poligono){
+            double valor = Punto_por(w, p);
+            double tol_p = Tolerancia(p) * std::max(1.0, std::hypot(w.x, w.y));
+            bool mejora = valor > mejor + tol_p;
+            bool empate = !mejora && valor >= mejor - tol_p;
+            if(mejora || (empate && std::hypot(p.x, p.y) < std::hypot(optimo.punto.x, optimo.punto.y))){
+                if(mejora) mejor = valor;
+                optimo.punto = p;
+            }
+        }
+        optimo.punto = Punto{ optimo.punto.x + 0.0, optimo.punto.y + 0.0 }; // sin -0
+        optimo.valor = cx * optimo.punto.x + cy * optimo.punto.y;
+        return optimo;
+    }
+}
@@ -1,14 +1,33 @@
 #include "../SDL_Visor/SDL_Visor.hpp"
 #include "parser.cpp"
+#include "simplex.cpp"
+#include "geometria.cpp"
+#include "traza.cpp"
+#include "restricciones.cpp"
 #include <map>
 #include <cmath>
 #include <algorithm>
 #include <vector>
 #include <fstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 
 std::map<String, vsr::Color*> Init_colors();
 std::vector<vsr::Color*> Init_colors_numeric();
-std::vector<PSR::Ecuation*> Obtener_sistema();
+RST::Tabla Obtener_sistema();
+RST::Tabla Tabla_desde_modelo(const SPX::Modelo& modelo);
+bool Cotas_graficables(const SPX::Modelo& modelo);
+int Resolver_sin_ventana(const SPX::Modelo& modelo);
+struct Modelo_lote {
+    SPX::Modelo modelo{2};
+    RST::Tabla tabla;   // las mismas restricciones, para verificar la solución
+    bool valido = true;
+};
+bool Leer_lote(std::istream& entrada, SPX::Sentido sentido, std::vector<Modelo_lote>& lote);
+void Resolver_lote(const std::vector<Modelo_lote>& lote, std::vector<SPX::Resultado>& resultados, std::vector<uint8_t>& verificados, unsigned hilos);
+int Modo_lote(int argc, char* argv[]);
 struct GraphParameters {
     int grid_x_start;
     int grid_y_start;
@@ -19,33 +38,75 @@ struct GraphParameters {
     float x_units;
     float y_units;
 };
-GraphParameters Crear_grafica_fondo(vsr::Screen* window, std::vector<PSR::Ecuation*> sistema);
-void Graficar_ecuacion(vsr::Screen* window, PSR::Ecuation* ecuacion, vsr::Color* color, GraphParameters& params);
-void Achurar_region_no_factible(vsr::Screen* window, PSR::Ecuation* ecuacion, vsr::Color* color, GraphParameters& params);
-void Calcular_punto_optimo(vsr::Screen* window, const std::vector<PSR::Ecuation*>& sistema, const std::vector<vsr::Color*>& colores_numeric, GraphParameters& params);
+GraphParameters Crear_grafica_fondo(vsr::Screen* window, const RST::Tabla& tabla);
+void Graficar_ecuacion(vsr::Screen* window, const RST::Tabla& tabla, size_t i, vsr::Color* color, GraphParameters& params);
+void Achurar_region_no_factible(vsr::Screen* window, const RST::Tabla& tabla, size_t i, vsr::Color* color, GraphParameters& params);
+void Rellenar_region_factible(vsr::Screen* window, const GEO::Region& region, vsr::Color* color, GraphParameters& params);
+void Calcular_punto_optimo(vsr::Screen* window, const GEO::Region& region, const RST::Tabla& tabla, const std::vector<vsr::Color*>& colores_numeric, GraphParameters& params);
+void Crear_capas(vsr::Screen* window, const RST::Tabla& tabla, const std::vector<vsr::Color*>& colores_numeric, GraphParameters& params);
+bool Iniciar_capa(vsr::Screen* window, size_t capa, int ancho, int alto);
+void Terminar_capa(vsr::Screen* window);
+void Dibujar_capas(vsr::Screen* window);
+void Liberar_capas();
 
 auto colores = Init_colors();
 auto colores_numerico = Init_colors_numeric();
 
-std::ofstream debugfile("debug.txt"); // Abre el archivo en modo de escritura (sobrescribe si existe)
+// Banderas que levanta el manejador de eventos de la ventana
+bool redibujar_ventana = true;   // hay que volver a componer las capas
+bool reconstruir_capas = false;  // cambió el tamaño: hay que volver a crearlas
+
+// Capas transparentes que se componen sobre "bg"
+enum Capa { Capa_achurado, Capa_rectas, Capa_optimo, NUM_CAPAS };
+SDL_Texture* capas[NUM_CAPAS] = {};
+
+int main(int argc, char* argv[]) {
+    // Trazas de depuración en debug.txt (se sobrescribe en cada ejecución)
+    TRZ::Sesion trazas("debug.txt");
 
-int main() {
     // Inicializar las tablas de colores
     std::map<String, vsr::Color*> colores = Init_colors();
     std::vector<vsr::Color*> colores_numerico = Init_colors_numeric();
 
-    // Obtener el sistema de ecuaciones
-    auto sistema = Obtener_sistema();
+    // Modo por lotes: muchos sistemas, sin ventana
+    if (argc > 1 && std::string(argv[1]) == "--lote") {
+        return Modo_lote(argc, argv);
+    }
+
+    // Obtener el sistema de ecuaciones: de un archivo de modelo (n variables)
+    // o de forma interactiva. Solo los modelos de 2 variables se grafican.
+    RST::Tabla tabla;
+    if (argc > 1) {
+        SPX::Modelo modelo;
+        {
+            TRZ_FASE(TRZ::Parseo);
+            if (!SPX::Leer_modelo(argv[1], modelo)) {
+                return 1;
+            }
+        }
+        if (modelo.Variables() != 2) {
+            return Resolver_sin_ventana(modelo);
+        }
+        if (!Cotas_graficables(modelo)) {
+            std::cout << "La gráfica solo muestra x1, x2 >= 0; con cotas inferiores negativas "
+                         "o libres el modelo se resuelve sin ventana\n";
+            return Resolver_sin_ventana(modelo);
+        }
+        tabla = Tabla_desde_modelo(modelo);
+    }
+    else {
+        tabla = Obtener_sistema();
+    }
 
     // Inicializar la ventana
     vsr::Screen window("Método gráfico de solución", 1000, 800, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
     window.Init_TTF("NotoSans", "../SDL_Visor/fonts/NotoSans/NotoSans-Thin.ttf", 15);
 
     // Crear la gráfica de fondo
-    auto graph_params = Crear_grafica_fondo(&window, sistema);
+    auto graph_params = Crear_grafica_fondo(&window, tabla);
 
     // Verificar que haya suficientes colores numéricos para las ecuaciones
-    size_t num_ecuaciones = sistema.size() - 1; // Excluyendo la ecuación objetivo en posición 0
+    size_t num_ecuaciones = tabla.Tamano(); // La función objetivo va aparte
     if (colores_numerico.size() < num_ecuaciones + 1) { // +1 para verde limón
         // Manejar el caso donde no hay suficientes colores
         size_t original_size = colores_numerico.size();
@@ -54,39 +115,53 @@ int main() {
         }
     }
 
+    // Las capas se dibujan una sola vez; el bucle solo las compone
+    Crear_capas(&window, tabla, colores_numerico, graph_params);
+    window.Set_events_handler([](SDL_Event& evento) {
+        // Algunos renderers pierden el contenido de las texturas destino
+        if (evento.type == SDL_RENDER_TARGETS_RESET || evento.type == SDL_RENDER_DEVICE_RESET) {
+            reconstruir_capas = true;
+            redibujar_ventana = true;
+            return;
+        }
+        if (evento.type != SDL_WINDOWEVENT) {
+            return;
+        }
+        if (evento.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || evento.window.event == SDL_WINDOWEVENT_RESIZED) {
+            reconstruir_capas = true;
+            redibujar_ventana = true;
+        }
+        else if (evento.window.event == SDL_WINDOWEVENT_EXPOSED) {
+            redibujar_ventana = true;
+        }
+    });
+
     // Bucle principal
     while (window.Handle_events()) {
-        // Dibujar el fondo de la gráfica
-        window.Draw_saved_texture("bg", nullptr);
-
-        // Achurar la región no factible para cada restricción
-        for (size_t i = 1; i < sistema.size(); ++i) {
-            // Asignar el color correspondiente a la ecuación
-            vsr::Color* color_actual = colores_numerico[i - 1];
-            Achurar_region_no_factible(&window, sistema[i], color_actual, graph_params);
+        if (reconstruir_capas) {
+            graph_params = Crear_grafica_fondo(&window, tabla);
+            Crear_capas(&window, tabla, colores_numerico, graph_params);
+            reconstruir_capas = false;
         }
-
-        // Graficar las ecuaciones del sistema, excluyendo la ecuación objetivo en posición 0
-        for (size_t i = 1; i < sistema.size(); ++i) {
-            // Asignar el mismo color correspondiente a la ecuación
-            vsr::Color* color_actual = colores_numerico[i - 1];
-            Graficar_ecuacion(&window, sistema[i], color_actual, graph_params);
+        if (redibujar_ventana) {
+            Dibujar_capas(&window);
+            window.Present_renderer();
+            redibujar_ventana = false;
         }
 
-        // Calcular y dibujar el punto óptimo
-        Calcular_punto_optimo(&window, sistema, colores_numerico, graph_params);
-
-        // Presentar el renderizador
-        window.Present_renderer();
-
-        // Control de la velocidad de actualización
-        SDL_Delay(1000);
+        // Esperar el siguiente evento sin sacarlo de la cola (lo atiende Handle_events)
+        SDL_WaitEvent(nullptr);
     }
 
+    Liberar_capas();
+
     // Liberar la memoria de los colores
     for (auto& pair : colores) {
         delete pair.second;
     }
+    // Con más ecuaciones que colores los punteros se repiten; cada uno se libera una vez
+    std::sort(colores_numerico.begin(), colores_numerico.end());
+    colores_numerico.erase(std::unique(colores_numerico.begin(), colores_numerico.end()), colores_numerico.end());
     for (auto color_ptr : colores_numerico) {
         delete color_ptr;
     }
@@ -103,7 +178,8 @@ std::map<String, vsr::Color*> Init_colors() {
         {"verde", new vsr::Color(0, 255, 0, 255)},
         {"azul", new vsr::Color(0, 0, 255, 255)},
         {"aqua", new vsr::Color(0, 100, 100, 255)},
-        {"cyan", new vsr::Color(0, 255, 255, 255)}
+        {"cyan", new vsr::Color(0, 255, 255, 255)},
+        {"factible", new vsr::Color(0, 200, 0, 60)} // Transparente para la región factible
     });
 }
 
@@ -123,8 +199,8 @@ std::vector<vsr::Color*> Init_colors_numeric() {
     });
 }
 
-std::vector<PSR::Ecuation*> Obtener_sistema() {
-    std::vector<PSR::Ecuation*> Ecuaciones;
+RST::Tabla Obtener_sistema() {
+    RST::Tabla tabla;
     float x1, x2, result;
     int cant_ecuaciones;
     char e;
@@ -132,17 +208,266 @@ std::vector<PSR::Ecuation*> Obtener_sistema() {
     scanf("%f %f", &x1, &x2);
     std::cout << "Ingrese la cantidad de restricciones\n";
     scanf("%d", &cant_ecuaciones);
-    Ecuaciones.push_back(new PSR::Ecuation(x1, x2, 0, '=')); // Ecuación objetivo
+    tabla.objetivo_x1 = x1; // Ecuación objetivo
+    tabla.objetivo_x2 = x2;
     for (int i = 0; i < cant_ecuaciones; i++) {
         std::cout << "Ingrese la restricción en el formato \"{x1} {x2} {operador} {resultado}\"\n";
         scanf("%f %f %c %f", &x1, &x2, &e, &result);
-        Ecuaciones.push_back(new PSR::Ecuation(x1, x2, result, e));
+        if (!tabla.Agregar(x1, x2, e, result)) {
+            std::cout << "Operador desconocido '" << e << "', se ignora la restricción\n";
+        }
     }
 
-    return Ecuaciones;
+    return tabla;
 }
 
-GraphParameters Crear_grafica_fondo(vsr::Screen* window, std::vector<PSR::Ecuation*> sistema) {
+RST::Tabla Tabla_desde_modelo(const SPX::Modelo& modelo) {
+    RST::Tabla tabla;
+    tabla.objetivo_x1 = modelo.Coef_objetivo(0);
+    tabla.objetivo_x2 = modelo.Coef_objetivo(1);
+    std::vector<double> coef;
+    char op;
+    double rhs;
+    for (size_t i = 0; i < modelo.Restricciones(); i++) {
+        modelo.Renglon(i, coef, op, rhs);
+        tabla.Agregar(coef[0], coef[1], op, rhs);
+    }
+    // Las cotas finitas se grafican como restricciones; x >= 0 ya lo supone la gráfica
+    for (size_t j = 0; j < 2; j++) {
+        double a = (j == 0) ? 1.0 : 0.0;
+        double b = 1.0 - a;
+        if (modelo.Cota_inferior(j) > 0) {
+            tabla.Agregar(a, b, '>', modelo.Cota_inferior(j));
+        }
+        if (modelo.Cota_superior(j) < SPX::INF) {
+            tabla.Agregar(a, b, '<', modelo.Cota_superior(j));
+        }
+    }
+    return tabla;
+}
+
+// La gráfica solo cubre el primer cuadrante: ninguna cota inferior puede ser negativa
+bool Cotas_graficables(const SPX::Modelo& modelo) {
+    for (size_t j = 0; j < modelo.Variables(); j++) {
+        if (!(modelo.Cota_inferior(j) >= 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Resuelve un modelo sin abrir la ventana (más de 2 variables o cotas que no se grafican)
+int Resolver_sin_ventana(const SPX::Modelo& modelo) {
+    SPX::Resultado res = SPX::Resolver(modelo);
+    std::cout << "Variables: " << modelo.Variables() << ", restricciones: " << modelo.Restricciones() << "\n";
+    std::cout << "Estado: " << SPX::Nombre_estado(res.estado) << "\n";
+    std::cout << "Iteraciones: " << res.iteraciones << " (" << res.pivotes_degenerados << " degeneradas)\n";
+    if (res.estado != SPX::Estado::Optimo) {
+        return 2;
+    }
+    if (res.degenerada) {
+        std::cout << "La solución óptima es degenerada\n";
+    }
+    std::cout << "Valor óptimo: " << res.valor << "\n";
+    for (size_t j = 0; j < res.x.size(); j++) {
+        if (res.x[j] != 0) {
+            std::cout << "x" << j + 1 << " = " << res.x[j] << "\n";
+        }
+    }
+    return 0;
+}
+
+/**
+ * Lee sistemas consecutivos en el mismo orden que Obtener_sistema:
+ *   x1 x2                (función objetivo)
+ *   n                    (cantidad de restricciones)
+ *   x1 x2 op resultado   (n renglones, los lee PSR::Parser)
+ * Las líneas vacías y las que empiezan con "--" se ignoran. Un sistema con
+ * un operador desconocido se marca como inválido; un renglón que no se puede
+ * leer termina la lectura.
+ */
+bool Leer_lote(std::istream& entrada, SPX::Sentido sentido, std::vector<Modelo_lote>& lote) {
+    std::string linea;
+    size_t num_linea = 0;
+    int pendientes = -1; // restricciones que faltan del sistema actual (-1: falta la cantidad)
+    bool hay_sistema = false;
+    while (std::getline(entrada, linea)) {
+        num_linea++;
+        size_t inicio = linea.find_first_not_of(" \t\r");
+        if (inicio == std::string::npos || linea.compare(inicio, 2, "--") == 0) {
+            continue;
+        }
+
+        if (!hay_sistema) {
+            float x1, x2;
+            if (sscanf(linea.c_str(), "%f %f", &x1, &x2) != 2) {
+                std::cerr << "Línea " << num_linea << ": se esperaba la función objetivo \"{x1} {x2}\"\n";
+                return false;
+            }
+            lote.emplace_back();
+            lote.back().modelo.Fijar_sentido(sentido);
+            lote.back().modelo.Fijar_objetivo(0, x1);
+            lote.back().modelo.Fijar_objetivo(1, x2);
+            lote.back().tabla.objetivo_x1 = x1;
+            lote.back().tabla.objetivo_x2 = x2;
+            hay_sistema = true;
+            pendientes = -1;
+        }
+        else if (pendientes < 0) {
+            if (sscanf(linea.c_str(), "%d", &pendientes) != 1 || pendientes < 0) {
+                std::cerr << "Línea " << num_linea << ": se esperaba la cantidad de restricciones\n";
+                lote.pop_back();
+                return false;
+            }
+        }
+        else {
+            PSR::Ecuation* ecuacion = PSR::Parser(linea);
+            if (ecuacion == nullptr) {
+                std::cerr << "Línea " << num_linea << ": se esperaba \"{x1} {x2} {operador} {resultado}\"\n";
+                lote.pop_back();
+                return false;
+            }
+            Modelo_lote& actual = lote.back();
+            if (!actual.modelo.Agregar_restriccion({ ecuacion->get_x1(), ecuacion->get_x2() },
+                                                  ecuacion->get_operator(), ecuacion->get_result())) {
+                actual.valido = false;
+            }
+            actual.tabla.Agregar(ecuacion->get_x1(), ecuacion->get_x2(), ecuacion->get_operator(), ecuacion->get_result());
+            delete ecuacion;
+            pendientes--;
+        }
+
+        if (hay_sistema && pendientes == 0) {
+            hay_sistema = false;
+        }
+    }
+    if (hay_sistema) {
+        std::cerr << "El último sistema está incompleto\n";
+        lote.pop_back();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Reparte los modelos entre los hilos en bloques tomados de un contador común.
+ * Cada óptimo se vuelve a revisar contra sus restricciones con RST::Factible;
+ * verificados[i] queda en 0 si no las cumple.
+ */
+void Resolver_lote(const std::vector<Modelo_lote>& lote, std::vector<SPX::Resultado>& resultados, std::vector<uint8_t>& verificados, unsigned hilos) {
+    const size_t bloque = 64;
+    resultados.assign(lote.size(), SPX::Resultado());
+    verificados.assign(lote.size(), 1);
+    std::atomic<size_t> siguiente(0);
+    auto trabajador = [&]() {
+        while (true) {
+            size_t inicio = siguiente.fetch_add(bloque);
+            if (inicio >= lote.size()) {
+                break;
+            }
+            size_t fin = std::min(inicio + bloque, lote.size());
+            for (size_t i = inicio; i < fin; i++) {
+                if (lote[i].valido) {
+                    resultados[i] = SPX::Resolver(lote[i].modelo);
+                    if (resultados[i].estado == SPX::Estado::Optimo) {
+                        verificados[i] = RST::Factible(lote[i].tabla, resultados[i].x[0], resultados[i].x[1]);
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    for (unsigned h = 1; h < hilos; h++) {
+        trabajadores.emplace_back(trabajador);
+    }
+    trabajador();
+    for (auto& t : trabajadores) {
+        t.join();
+    }
+}
+
+/**
+ * ./metodo_grafico --lote [archivo|-] [max|min] [-h hilos]
+ * Escribe en la salida estándar un renglón por sistema:
+ *   indice estado x1 x2 z
+ * ("-" en x1 x2 z cuando no hay óptimo; "no_verificado" si el óptimo no
+ * cumple sus restricciones) y al final, en la salida de errores, el
+ * rendimiento en modelos por segundo.
+ */
+int Modo_lote(int argc, char* argv[]) {
+    std::string archivo = "-";
+    SPX::Sentido sentido = SPX::Sentido::Maximizar;
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "max") sentido = SPX::Sentido::Maximizar;
+        else if (arg == "min") sentido = SPX::Sentido::Minimizar;
+        else if (arg == "-h" && i + 1 < argc) hilos = std::max(1, atoi(argv[++i]));
+        else archivo = arg;
+    }
+
+    std::ios::sync_with_stdio(false);
+    using Reloj = std::chrono::steady_clock;
+    auto t0 = Reloj::now();
+    std::vector<Modelo_lote> lote;
+    bool lectura_ok;
+    {
+        TRZ_FASE(TRZ::Parseo);
+        if (archivo == "-") {
+            lectura_ok = Leer_lote(std::cin, sentido, lote);
+        }
+        else {
+            std::ifstream entrada(archivo);
+            if (!entrada.is_open()) {
+                std::cerr << "No se pudo abrir el archivo: " << archivo << "\n";
+                return 1;
+            }
+            lectura_ok = Leer_lote(entrada, sentido, lote);
+        }
+    }
+    TRZ_CONTAR(TRZ::Modelos, lote.size());
+    auto t1 = Reloj::now();
+
+    std::vector<SPX::Resultado> resultados;
+    std::vector<uint8_t> verificados;
+    Resolver_lote(lote, resultados, verificados, hilos);
+    auto t2 = Reloj::now();
+
+    std::ostringstream salida;
+    salida << std::setprecision(10);
+    salida << "# indice estado x1 x2 z\n";
+    size_t no_verificados = 0;
+    for (size_t i = 0; i < lote.size(); i++) {
+        const SPX::Resultado& res = resultados[i];
+        salida << i + 1 << " ";
+        if (!lote[i].valido) {
+            salida << "invalido - - -\n";
+        }
+        else if (res.estado != SPX::Estado::Optimo) {
+            salida << SPX::Nombre_estado(res.estado) << " - - -\n";
+        }
+        else {
+            no_verificados += !verificados[i];
+            salida << (verificados[i] ? "optimo " : "no_verificado ") << res.x[0] << " " << res.x[1] << " " << res.valor << "\n";
+        }
+    }
+    std::cout << salida.str() << std::flush;
+
+    double t_lectura = std::chrono::duration<double>(t1 - t0).count();
+    double t_solucion = std::chrono::duration<double>(t2 - t1).count();
+    std::cerr << lote.size() << " modelos con " << hilos << " hilos: lectura " << t_lectura
+              << " s, solución " << t_solucion << " s, "
+              << (t_solucion > 0 ? lote.size() / t_solucion : 0.0) << " modelos/s (kernel "
+              << RST::Nombre_kernel(RST::Kernel_disponible()) << ")\n";
+    if (no_verificados > 0) {
+        std::cerr << no_verificados << " óptimos no cumplen sus restricciones\n";
+        TRZ_ERROR("%zu óptimos del lote no cumplen sus restricciones", no_verificados);
+    }
+    return lectura_ok ? 0 : 1;
+}
+
+GraphParameters Crear_grafica_fondo(vsr::Screen* window, const RST::Tabla& tabla) {
     int width, height;
     window->Get_window_sizes(&width, &height);
     window->Create_texture("bg", width, height);
@@ -157,11 +482,10 @@ GraphParameters Crear_grafica_fondo(vsr::Screen* window, std::vector<PSR::Ecuati
     float max_x = 0.0f;
     float max_y = 0.0f;
 
-    for (size_t i = 1; i < sistema.size(); ++i) {
-        PSR::Ecuation* ecuacion = sistema[i];
-        float a = ecuacion->get_x1();
-        float b = ecuacion->get_x2();
-        float c = ecuacion->get_result();
+    for (size_t i = 0; i < tabla.Tamano(); ++i) {
+        float a = tabla.a[i];
+        float b = tabla.b[i];
+        float c = tabla.c[i];
 
         // Encontrar intersecciones con los ejes
         float x_intercept = (a != 0) ? c / a : 0.0f;
@@ -265,11 +589,150 @@ struct Point {
     float y;
 };
 
-void Graficar_ecuacion(vsr::Screen* window, PSR::Ecuation* ecuacion, vsr::Color* color, GraphParameters& params) {
+/**
+ * Dibuja en texturas el achurado, las rectas de las restricciones y los
+ * puntos óptimos. Son transparentes fuera de lo dibujado para componerlas
+ * sobre "bg"; se vuelven a crear solo si cambia el tamaño de la ventana
+ * o el renderer pierde sus texturas.
+ */
+void Crear_capas(vsr::Screen* window, const RST::Tabla& tabla, const std::vector<vsr::Color*>& colores_numeric, GraphParameters& params) {
+    int width, height;
+    window->Get_window_sizes(&width, &height);
+
+    // Región factible exacta (polígono convexo)
+    GEO::Region region;
+    {
+        TRZ_FASE(TRZ::Interseccion);
+        std::vector<GEO::Semiplano> semiplanos;
+        for (size_t i = 0; i < tabla.Tamano(); ++i) {
+            GEO::Agregar_restriccion(semiplanos, tabla.a[i], tabla.b[i], tabla.operador[i], tabla.c[i]);
+        }
+        region = GEO::Region_factible(semiplanos);
+    }
+    TRZ_CONTAR(TRZ::Restricciones, tabla.Tamano());
+    TRZ_CONTAR(TRZ::Vertices, region.poligono.size());
+    TRZ_INFO("Región factible: %zu restricciones, %zu vértices", tabla.Tamano(), region.poligono.size());
+
+    // Revisar todos los vértices contra la tabla de una vez y quitar los que
+    // no la cumplan, para que no se rellenen ni compitan por el óptimo
+    {
+        TRZ_FASE(TRZ::Filtrado);
+        std::vector<double> xs, ys;
+        for (const auto& p : region.poligono) {
+            xs.push_back(p.x);
+            ys.push_back(p.y);
+        }
+        std::vector<uint8_t> factibles(region.poligono.size());
+        size_t validos = RST::Factibles(tabla, xs.data(), ys.data(), xs.size(), factibles.data());
+        if (validos < region.poligono.size()) {
+            TRZ_ERROR("%zu de %zu vértices no cumplen las restricciones; se descartan",
+                      region.poligono.size() - validos, region.poligono.size());
+            size_t k = 0;
+            for (size_t i = 0; i < region.poligono.size(); ++i) {
+                if (factibles[i]) region.poligono[k++] = region.poligono[i];
+            }
+            region.poligono.resize(k);
+        }
+    }
+#if TRZ_NIVEL >= TRZ_NIVEL_DEPURACION
+    for (const auto& p : region.poligono) {
+        TRZ_DEPURAR("Vértice (%g, %g)", p.x, p.y);
+    }
+#endif
+
+    {
+        TRZ_FASE(TRZ::Dibujo);
+
+        // Rellenar la región factible y achurar la región no factible de cada restricción
+        Iniciar_capa(window, Capa_achurado, width, height);
+        Rellenar_region_factible(window, region, colores["factible"], params);
+        for (size_t i = 0; i < tabla.Tamano(); ++i) {
+            Achurar_region_no_factible(window, tabla, i, colores_numeric[i], params);
+        }
+        Terminar_capa(window);
+
+        // Graficar las restricciones del sistema (la función objetivo va aparte en la tabla)
+        Iniciar_capa(window, Capa_rectas, width, height);
+        for (size_t i = 0; i < tabla.Tamano(); ++i) {
+            Graficar_ecuacion(window, tabla, i, colores_numeric[i], params);
+        }
+        Terminar_capa(window);
+    }
+
+    // Calcular y dibujar el punto óptimo
+    Iniciar_capa(window, Capa_optimo, width, height);
+    Calcular_punto_optimo(window, region, tabla, colores_numeric, params);
+    Terminar_capa(window);
+
+    TRZ_CONTAR(TRZ::Capas, NUM_CAPAS);
+    redibujar_ventana = true;
+}
+
+/**
+ * Crea la textura de una capa y la deja como destino del renderer, limpia
+ * en transparente. Se crea aquí con SDL (RGBA y mezcla propia) en lugar de
+ * con Create_texture, porque de SDL_Visor solo se necesita el renderer y
+ * así la transparencia no depende del formato de sus texturas.
+ *
+ * Al dibujar encima con mezcla alfa normal, sobre un fondo (0,0,0,0) la
+ * capa queda con el color ya multiplicado por su alfa; por eso se compone
+ * con src·1 + dst·(1 - alfa), que da el mismo color que dibujar
+ * directamente sobre "bg". Si el renderer no admite esa mezcla se usa la
+ * normal (los translúcidos se ven un poco más oscuros).
+ */
+bool Iniciar_capa(vsr::Screen* window, size_t capa, int ancho, int alto) {
+    SDL_Renderer* renderer = window->Get_renderer();
+    if (capas[capa] != nullptr) {
+        SDL_DestroyTexture(capas[capa]);
+    }
+    capas[capa] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, ancho, alto);
+    if (capas[capa] == nullptr) {
+        TRZ_ERROR("No se pudo crear la capa %zu: %s", capa, SDL_GetError());
+        return false;
+    }
+    static const SDL_BlendMode premultiplicada = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(capas[capa], premultiplicada) != 0) {
+        SDL_SetTextureBlendMode(capas[capa], SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_SetRenderTarget(renderer, capas[capa]);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void Terminar_capa(vsr::Screen* window) {
+    SDL_SetRenderTarget(window->Get_renderer(), nullptr);
+}
+
+void Dibujar_capas(vsr::Screen* window) {
+    TRZ_FASE(TRZ::Dibujo);
+    window->Draw_saved_texture("bg", nullptr);
+    for (SDL_Texture* capa : capas) {
+        if (capa != nullptr) {
+            SDL_RenderCopy(window->Get_renderer(), capa, nullptr, nullptr);
+        }
+    }
+}
+
+void Liberar_capas() {
+    for (SDL_Texture*& capa : capas) {
+        if (capa != nullptr) {
+            SDL_DestroyTexture(capa);
+            capa = nullptr;
+        }
+    }
+}
+
+void Graficar_ecuacion(vsr::Screen* window, const RST::Tabla& tabla, size_t i, vsr::Color* color, GraphParameters& params) {
     // Obtener los coeficientes de la ecuación
-    float a = ecuacion->get_x1();
-    float b = ecuacion->get_x2();
-    float c = ecuacion->get_result();
+    float a = tabla.a[i];
+    float b = tabla.b[i];
+    float c = tabla.c[i];
 
     // Lista para almacenar puntos de intersección válidos
     std::vector<Point> puntos;
@@ -337,166 +800,158 @@ void Graficar_ecuacion(vsr::Screen* window, PSR::Ecuation* ecuacion, vsr::Color*
         x_pixel_2, y_pixel_2,
         *color);
 }
-void Achurar_region_no_factible(vsr::Screen* window, PSR::Ecuation* ecuacion, vsr::Color* color, GraphParameters& params) {
-    // Obtener los coeficientes de la ecuación
-    float a = ecuacion->get_x1();
-    float b = ecuacion->get_x2();
-    float c = ecuacion->get_result();
-    char operador = ecuacion->get_operator(); // Necesitamos esta función en la clase PSR::Ecuation
+// Convierte un punto de la gráfica a coordenadas de píxeles
+GEO::Punto A_pixeles(GEO::Punto p, const GraphParameters& params) {
+    return GEO::Punto{ params.grid_x_start + p.x * params.pixels_per_unit_x,
+                       params.grid_y_start + params.grid_height - p.y * params.pixels_per_unit_y };
+}
 
-    // Definir la función que verifica si un punto está en la región no factible
-    auto es_no_factible = [=](float x, float y) -> bool {
-        float valor = a * x + b * y;
-        switch (operador) {
-            case '<':
-                return valor > c; // Región no factible es donde la restricción no se cumple
-            case '>':
-                return valor < c;
-            case '=':
-                return valor != c;
-            default:
-                return false;
-        }
-    };
+// Polígono de la parte visible de la gráfica: [0, x_units] x [0, y_units]
+std::vector<GEO::Punto> Vista(const GraphParameters& params) {
+    return { GEO::Punto{ 0, 0 }, GEO::Punto{ params.x_units, 0 },
+             GEO::Punto{ params.x_units, params.y_units }, GEO::Punto{ 0, params.y_units } };
+}
 
-    // Dibujar líneas de achurado sobre la región no factible
-    int step = 10; // Espacio entre líneas de achurado
-    for (int y_pixel = params.grid_y_start; y_pixel <= params.grid_y_start + params.grid_height; y_pixel += step) {
-        // Convertir y_pixel a coordenada y
-        float y = params.y_units - ((float)(y_pixel - params.grid_y_start) / params.pixels_per_unit_y);
-        for (int x_pixel = params.grid_x_start; x_pixel <= params.grid_x_start + params.grid_width; x_pixel += step) {
-            // Convertir x_pixel a coordenada x
-            float x = (float)(x_pixel - params.grid_x_start) / params.pixels_per_unit_x;
+/**
+ * Achura un polígono convexo (en coordenadas de la gráfica) con líneas a
+ * 45° cada "step" píxeles, recortando cada línea con el polígono.
+ */
+void Achurar_poligono(vsr::Screen* window, const std::vector<GEO::Punto>& poligono, vsr::Color* color, GraphParameters& params, int step) {
+    if (poligono.size() < 3) {
+        return;
+    }
+    std::vector<GEO::Punto> pixeles;
+    double min_x = INFINITY, max_x = -INFINITY, min_y = INFINITY, max_y = -INFINITY;
+    for (const auto& p : poligono) {
+        pixeles.push_back(A_pixeles(p, params));
+        min_x = std::min(min_x, pixeles.back().x);
+        max_x = std::max(max_x, pixeles.back().x);
+        min_y = std::min(min_y, pixeles.back().y);
+        max_y = std::max(max_y, pixeles.back().y);
+    }
 
-            if (es_no_factible(x, y)) {
-                // Dibujar un pequeño rectángulo o punto en (x_pixel, y_pixel)
-                window->Draw_rectangle(x_pixel, y_pixel, 5, 5, *color);
-            }
+    // Rectas x - y = k; k en múltiplos de step para que todos los achurados coincidan
+    int k_inicio = static_cast<int>(std::floor((min_x - max_y) / step)) * step;
+    uint64_t lineas = 0;
+    for (int k = k_inicio; k <= max_x - min_y; k += step) {
+        GEO::Punto p{ k + min_y, min_y };
+        GEO::Punto q{ k + max_y, max_y };
+        if (GEO::Recortar_segmento(pixeles, p, q)) {
+            window->Draw_line_pos(std::lround(p.x), std::lround(p.y), std::lround(q.x), std::lround(q.y), *color);
+            lineas++;
         }
     }
+    TRZ_CONTAR(TRZ::Lineas_achurado, lineas);
 }
-void Calcular_punto_optimo(vsr::Screen *window, 
-                           const std::vector<PSR::Ecuation *> &sistema, 
-                           const std::vector<vsr::Color *> &colores_numeric, 
-                           GraphParameters &params) {
-    // Abrir el archivo de depuración en modo de añadir
-    std::ofstream debugfile("debug.txt", std::ios::app);
-    if (!debugfile.is_open()) {
-        std::cerr << "Error al abrir debug.txt para escritura." << std::endl;
-        return;
-    }
-
-    std::vector<Point> vertices;
 
-    // Encontrar todas las intersecciones de pares de ecuaciones
-    for (size_t i = 0; i < sistema.size(); ++i) {
-        for (size_t j = i + 1; j < sistema.size(); ++j) {
-            float a1 = sistema[i]->get_x1();
-            float b1 = sistema[i]->get_x2();
-            float c1 = sistema[i]->get_result();
-
-            float a2 = sistema[j]->get_x1();
-            float b2 = sistema[j]->get_x2();
-            float c2 = sistema[j]->get_result();
-
-            // Calcular el determinante
-            float det = a1 * b2 - a2 * b1;
-            if (std::abs(det) < 1e-6) {
-                // Las líneas son paralelas o coincidentes
-                continue;
-            }
-
-            // Calcular el punto de intersección
-            float x = (c1 * b2 - c2 * b1) / det;
-            float y = (a1 * c2 - a2 * c1) / det;
-
-            // Crear el punto
-            Point p = { x, y };
-            debugfile << "Intersección encontrada: (" << p.x << ", " << p.y << ")\n";
-            vertices.push_back(p);
-        }
+void Achurar_region_no_factible(vsr::Screen* window, const RST::Tabla& tabla, size_t i, vsr::Color* color, GraphParameters& params) {
+    // Obtener los coeficientes de la ecuación
+    double a = tabla.a[i];
+    double b = tabla.b[i];
+    double c = tabla.c[i];
+    char operador = tabla.operador[i];
+
+    // Semiplanos donde la restricción no se cumple (una igualdad no se cumple a ningún lado de la recta)
+    std::vector<GEO::Semiplano> no_factibles;
+    switch (operador) {
+        case '<':
+            no_factibles.push_back(GEO::Semiplano{ -a, -b, -c });
+            break;
+        case '>':
+            no_factibles.push_back(GEO::Semiplano{ a, b, c });
+            break;
+        case '=':
+            no_factibles.push_back(GEO::Semiplano{ -a, -b, -c });
+            no_factibles.push_back(GEO::Semiplano{ a, b, c });
+            break;
+        default:
+            return;
     }
 
-    // Filtrar los puntos que están dentro de la región factible
-    std::vector<Point> puntos_factibles;
-    for (const auto& p : vertices) {
-        bool es_factible = true;
-        // Omitir la primera ecuación (índice 0) ya que es la función a maximizar
-        for (size_t k = 1; k < sistema.size(); ++k) {
-            const auto& ecuacion = sistema[k];
-            float lhs = ecuacion->get_x1() * p.x + ecuacion->get_x2() * p.y;
-            float rhs = ecuacion->get_result();
-            char op = ecuacion->get_operator();
+    // Dibujar líneas de achurado sobre la región no factible visible
+    int step = 10; // Espacio entre líneas de achurado
+    for (const auto& semiplano : no_factibles) {
+        Achurar_poligono(window, GEO::Recortar(Vista(params), semiplano), color, params, step);
+    }
+}
 
-            debugfile << "Evaluando punto (" << p.x << ", " << p.y << ") contra ecuación " << k << ": ";
-            debugfile << lhs << " " << op << " " << rhs << " -> ";
+/**
+ * Rellena la región factible visible con líneas horizontales de un píxel.
+ * Si la región es un segmento (por una igualdad) solo se dibuja el segmento.
+ */
+void Rellenar_region_factible(vsr::Screen* window, const GEO::Region& region, vsr::Color* color, GraphParameters& params) {
+    if (region.poligono.empty()) {
+        return;
+    }
+    std::vector<GEO::Punto> visible = GEO::Recortar(region.poligono, GEO::Semiplano{ 1, 0, params.x_units });
+    visible = GEO::Recortar(visible, GEO::Semiplano{ 0, 1, params.y_units });
+    if (visible.empty()) {
+        return;
+    }
 
-            if (op == '<') {
-                if (!(lhs <= rhs + 1e-6)) { // Tolerancia ajustada a 1e-6
-                    es_factible = false;
-                    debugfile << "No cumple con <\n";
-                    break;
-                }
-            }
-            else if (op == '>') {
-                if (!(lhs >= rhs - 1e-6)) { // Tolerancia ajustada a 1e-6
-                    es_factible = false;
-                    debugfile << "No cumple con >\n";
-                    break;
-                }
-            }
-            else if (op == '=') {
-                if (!(std::abs(lhs - rhs) <= 1e-6)) { // Tolerancia ajustada a 1e-6
-                    es_factible = false;
-                    debugfile << "No cumple con =\n";
-                    break;
-                }
-            }
-            debugfile << "Cumple\n";
+    std::vector<GEO::Punto> pixeles;
+    double min_y = INFINITY, max_y = -INFINITY;
+    for (const auto& p : visible) {
+        pixeles.push_back(A_pixeles(p, params));
+        min_y = std::min(min_y, pixeles.back().y);
+        max_y = std::max(max_y, pixeles.back().y);
+    }
+    if (pixeles.size() < 3) {
+        GEO::Punto p = pixeles.front(), q = pixeles.back();
+        window->Draw_line_pos(std::lround(p.x), std::lround(p.y), std::lround(q.x), std::lround(q.y), *color);
+        return;
+    }
+    for (int y = static_cast<int>(std::ceil(min_y)); y <= max_y; y++) {
+        GEO::Punto p{ params.grid_x_start - 1.0, static_cast<double>(y) };
+        GEO::Punto q{ params.grid_x_start + params.grid_width + 1.0, static_cast<double>(y) };
+        if (GEO::Recortar_segmento(pixeles, p, q)) {
+            window->Draw_line_pos(std::lround(p.x), y, std::lround(q.x), y, *color);
         }
+    }
+}
 
-        if (es_factible) {
-            // Verificar si el punto está dentro de los límites de la gráfica
-            debugfile << "Punto factible: (" << p.x << ", " << p.y << ")\n";
-            if (p.x >= 0 && p.x <= params.x_units && p.y >= 0 && p.y <= params.y_units) {
-                puntos_factibles.push_back(p);
-                debugfile << "Añadido a puntos_factibles.\n";
-            }
-            else {
-                debugfile << "Fuera de los límites de la gráfica.\n";
-            }
-        }
+void Calcular_punto_optimo(vsr::Screen *window, 
+                           const GEO::Region &region,
+                           const RST::Tabla &tabla, 
+                           const std::vector<vsr::Color *> &colores_numeric, 
+                           GraphParameters &params) {
+    // Óptimos en ambos sentidos recorriendo los vértices de la región
+    GEO::Optimo res_max, res_min;
+    {
+        TRZ_FASE(TRZ::Filtrado);
+        res_max = GEO::Optimizar(region, tabla.objetivo_x1, tabla.objetivo_x2, true);
+        res_min = GEO::Optimizar(region, tabla.objetivo_x1, tabla.objetivo_x2, false);
     }
+    [[maybe_unused]] auto estado = [](const GEO::Optimo& res) {
+        return !res.factible ? "infactible" : (!res.acotado ? "no_acotado" : "optimo");
+    };
+    TRZ_INFO("Maximización: %s", estado(res_max));
+    TRZ_INFO("Minimización: %s", estado(res_min));
 
-    if (puntos_factibles.empty()) {
+    if (!res_max.factible) {
         // No hay puntos factibles
-        debugfile << "Sin puntos factibles.\n";
-        debugfile.close();
+        TRZ_INFO("Sin puntos factibles.");
         return;
     }
 
-    // Seleccionar el punto de maximización (más arriba y a la derecha)
-    Point optimo_max = puntos_factibles[0];
-    float max_sum = optimo_max.x + optimo_max.y;
-
-    // Seleccionar el punto de minimización (más abajo y a la izquierda)
-    Point optimo_min = puntos_factibles[0];
-    float min_sum = optimo_min.x + optimo_min.y;
-
-    for (const auto& p : puntos_factibles) {
-        float current_sum = p.x + p.y;
-        if (current_sum > max_sum) {
-            max_sum = current_sum;
-            optimo_max = p;
-        }
-        if (current_sum < min_sum) {
-            min_sum = current_sum;
-            optimo_min = p;
-        }
+    // Si un sentido no está acotado no tiene punto óptimo que marcar; tampoco
+    // se marca un óptimo que queda fuera de la parte visible de la gráfica
+    auto visible = [&](const GEO::Punto& p) {
+        return p.x <= params.x_units && p.y <= params.y_units;
+    };
+    bool hay_max = res_max.acotado;
+    bool hay_min = res_min.acotado;
+    Point optimo_max = hay_max ? Point{ (float)res_max.punto.x, (float)res_max.punto.y } : Point{ 0, 0 };
+    Point optimo_min = hay_min ? Point{ (float)res_min.punto.x, (float)res_min.punto.y } : Point{ 0, 0 };
+
+    if (hay_max) {
+        TRZ_INFO("Punto de maximización: (%g, %g), z = %g", optimo_max.x, optimo_max.y, res_max.valor);
+        hay_max = visible(res_max.punto);
+    }
+    if (hay_min) {
+        TRZ_INFO("Punto de minimización: (%g, %g), z = %g", optimo_min.x, optimo_min.y, res_min.valor);
+        hay_min = visible(res_min.punto);
     }
-
-    debugfile << "Punto de maximización: (" << optimo_max.x << ", " << optimo_max.y << ")\n";
-    debugfile << "Punto de minimización: (" << optimo_min.x << ", " << optimo_min.y << ")\n";
 
     // Convertir los puntos óptimos a coordenadas de píxeles
     int x_pixel_max = params.grid_x_start + static_cast<int>(optimo_max.x * params.pixels_per_unit_x);
@@ -507,8 +962,7 @@ void Calcular_punto_optimo(vsr::Screen *window,
 
     // Definir los colores rojo y azul
     if (colores_numeric.size() < 3) { // Asegurarse de que los índices 0 y 2 existan
-        debugfile << "No hay suficientes colores en colores_numeric.\n";
-        debugfile.close();
+        TRZ_ERROR("No hay suficientes colores en colores_numeric.");
         return;
     }
     vsr::Color* rojo = colores_numeric[0]; // Rojo en índice 0
@@ -519,15 +973,16 @@ void Calcular_punto_optimo(vsr::Screen *window,
     uint16_t resolucion = 32; // Número de segmentos para el círculo
 
     // Dibujar el círculo en el punto de maximización (rojo)
-    window->Draw_circle(x_pixel_max, y_pixel_max, radio, resolucion, *rojo);
-    debugfile << "Círculo rojo dibujado en (" << x_pixel_max << ", " << y_pixel_max << ")\n";
+    if (hay_max) {
+        window->Draw_circle(x_pixel_max, y_pixel_max, radio, resolucion, *rojo);
+        TRZ_DEPURAR("Círculo rojo dibujado en (%d, %d)", x_pixel_max, y_pixel_max);
+    }
 
     // Dibujar el círculo en el punto de minimización (azul)
-    window->Draw_circle(x_pixel_min, y_pixel_min, radio, resolucion, *azul);
-    debugfile << "Círculo azul dibujado en (" << x_pixel_min << ", " << y_pixel_min << ")\n";
-
-    // Cerrar el archivo de depuración
-    debugfile.close();
+    if (hay_min) {
+        window->Draw_circle(x_pixel_min, y_pixel_min, radio, resolucion, *azul);
+        TRZ_DEPURAR("Círculo azul dibujado en (%d, %d)", x_pixel_min, y_pixel_min);
+    }
 }
 /*
 void Achurar_region_no_factible(vsr::Screen* window, PSR::Ecuation* ecuacion, vsr::Color* color, GraphParameters& params) {
@@ -17,7 +17,8 @@ namespace PSR{
     Ecuation* Parser(std::string ecuation){
         float x1,x2,result;
         char e;
-        sscanf(ecuation.c_str(),"%f %f %c %f",&x1,&x2,&e,&result);
+        if(sscanf(ecuation.c_str(),"%f %f %c %f",&x1,&x2,&e,&result) != 4)
+            return nullptr; // renglón incompleto
         return new Ecuation(x1,x2,result,e);
 
     }
@@ -0,0 +1,327 @@
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RST_X86 1
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// Tabla de restricciones de 2 variables en arreglos contiguos.      //
+//                                                                    //
+// Además de los coeficientes tal como se escribieron, se guarda una  //
+// forma normalizada para revisar factibilidad sin ramas:             //
+//     a·x + b·y - c <= tol·e        (una ">" se guarda negada)        //
+//     |a·x + b·y - c| <= tol·e      (igualdad, marcada con máscara)   //
+// con e = max(1, |x|, |y|) para que la tolerancia crezca con el punto. //
+// Los arreglos normalizados se rellenan hasta un múltiplo de 4 con    //
+// renglones neutros, así los kernels AVX2/SSE2 no tienen cola. El     //
+// kernel se elige una sola vez según el procesador.                  //
+//                                                                    //
+// Hay dos formas de vectorizar: Factible recorre las restricciones   //
+// de un punto de 4 en 4, y Factibles revisa lotes de puntos (4 por   //
+// registro en AVX2) con el ciclo de restricciones por fuera, así     //
+// cada renglón se carga una vez por grupo de puntos.                 //
+//////////////////////////////////////////////////////////////////////
+
+namespace RST {
+
+    const size_t BLOQUE = 4;
+    const double TOL_FACT = 1e-7;
+
+    class Tabla {
+        private:
+        size_t cantidad = 0;
+
+        public:
+        double objetivo_x1 = 0, objetivo_x2 = 0;
+
+        // Como se escribieron
+        std::vector<double> a, b, c;
+        std::vector<char> operador;
+
+        // Forma normalizada, rellenada a múltiplo de BLOQUE
+        std::vector<double> na, nb, nc, tol;
+        std::vector<double> igualdad;   // bits en 1 si es igualdad, 0 si no
+
+        size_t Tamano() const { return cantidad; }
+        size_t Tamano_relleno() const { return na.size(); }
+
+        // Devuelve false si el operador no es <, > o =
+        bool Agregar(double a, double b, char op, double c){
+            if(op != '<' && op != '>' && op != '=')
+                return false;
+            this->a.push_back(a);
+            this->b.push_back(b);
+            this->c.push_back(c);
+            operador.push_back(op);
+
+            if(cantidad == na.size()){
+                // Renglones neutros: 0·x + 0·y - 0 <= 1
+                na.resize(cantidad + BLOQUE, 0.0);
+                nb.resize(cantidad + BLOQUE, 0.0);
+                nc.resize(cantidad + BLOQUE, 0.0);
+                tol.resize(cantidad + BLOQUE, 1.0);
+                igualdad.resize(cantidad + BLOQUE, 0.0);
+            }
+            double signo = (op == '>') ? -1.0 : 1.0;
+            na[cantidad] = signo * a;
+            nb[cantidad] = signo * b;
+            nc[cantidad] = signo * c;
+            tol[cantidad] = TOL_FACT * std::max({ 1.0, std::abs(a) + std::abs(b), std::abs(c) });
+            uint64_t bits = (op == '=') ? ~0ULL : 0ULL;
+            std::copy_n(reinterpret_cast<const char*>(&bits), sizeof(double),
+                        reinterpret_cast<char*>(&igualdad[cantidad]));
+            cantidad++;
+            return true;
+        }
+
+        void Limpiar(){
+            cantidad = 0;
+            a.clear(); b.clear(); c.clear(); operador.clear();
+            na.clear(); nb.clear(); nc.clear(); tol.clear(); igualdad.clear();
+        }
+    };
+
+    static double Escala(double x, double y){
+        return std::max({ 1.0, std::abs(x), std::abs(y) });
+    }
+
+    // Referencia: un renglón a la vez
+    bool Factible_escalar(const Tabla& t, double x, double y){
+        const size_t n = t.Tamano();
+        const double e = Escala(x, y);
+        for(size_t i = 0; i < n; i++){
+            double v = t.na[i] * x + t.nb[i] * y - t.nc[i];
+            bool es_igualdad = t.operador[i] == '=';
+            if(!((es_igualdad ? std::abs(v) : v) <= t.tol[i] * e)) // un NaN no es factible
+                return false;
+        }
+        return true;
+    }
+
+#ifdef RST_X86
+    __attribute__((target("sse2")))
+    bool Factible_sse2(const Tabla& t, double x, double y){
+        const size_t n = t.Tamano_relleno();
+        const __m128d vx = _mm_set1_pd(x);
+        const __m128d vy = _mm_set1_pd(y);
+        const __m128d signo = _mm_set1_pd(-0.0);
+        const __m128d e = _mm_set1_pd(Escala(x, y));
+        for(size_t i = 0; i < n; i += 2){
+            __m128d v = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(_mm_loadu_pd(&t.na[i]), vx),
+                                              _mm_mul_pd(_mm_loadu_pd(&t.nb[i]), vy)),
+                                   _mm_loadu_pd(&t.nc[i]));
+            // En las igualdades se quita el signo: |v|
+            __m128d quitar = _mm_and_pd(_mm_loadu_pd(&t.igualdad[i]), signo);
+            v = _mm_andnot_pd(quitar, v);
+            if(_mm_movemask_pd(_mm_cmpnle_pd(v, _mm_mul_pd(_mm_loadu_pd(&t.tol[i]), e))))
+                return false;
+        }
+        return true;
+    }
+
+    __attribute__((target("avx2")))
+    bool Factible_avx2(const Tabla& t, double x, double y){
+        const size_t n = t.Tamano_relleno();
+        const __m256d vx = _mm256_set1_pd(x);
+        const __m256d vy = _mm256_set1_pd(y);
+        const __m256d signo = _mm256_set1_pd(-0.0);
+        const __m256d e = _mm256_set1_pd(Escala(x, y));
+        for(size_t i = 0; i < n; i += BLOQUE){
+            __m256d v = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(&t.na[i]), vx),
+                                                    _mm256_mul_pd(_mm256_loadu_pd(&t.nb[i]), vy)),
+                                      _mm256_loadu_pd(&t.nc[i]));
+            __m256d quitar = _mm256_and_pd(_mm256_loadu_pd(&t.igualdad[i]), signo);
+            v = _mm256_andnot_pd(quitar, v);
+            if(_mm256_movemask_pd(_mm256_cmp_pd(v, _mm256_mul_pd(_mm256_loadu_pd(&t.tol[i]), e), _CMP_NLE_UQ)))
+                return false;
+        }
+        return true;
+    }
+#endif
+
+    /**
+     * Kernels por lotes: cada punto guarda en 'falla' si alguna restricción
+     * lo dejó fuera. Se revisan grupos de puntos contra un renglón a la vez
+     * y se corta (cada BLOQUE renglones) en cuanto todo el grupo falló. Las
+     * coordenadas del último grupo incompleto se copian a un arreglo con ceros.
+     */
+    size_t Factibles_escalar(const Tabla& t, const double* x, const double* y, size_t puntos, uint8_t* factible){
+        size_t total = 0;
+        for(size_t k = 0; k < puntos; k++){
+            factible[k] = Factible_escalar(t, x[k], y[k]);
+            total += factible[k];
+        }
+        return total;
+    }
+
+#ifdef RST_X86
+    __attribute__((target("sse2")))
+    size_t Factibles_sse2(const Tabla& t, const double* x, const double* y, size_t puntos, uint8_t* factible){
+        const size_t GRUPO = 8;   // 4 registros de 2 puntos
+        const size_t n = t.Tamano();
+        const __m128d signo = _mm_set1_pd(-0.0);
+        const __m128d uno = _mm_set1_pd(1.0);
+        size_t total = 0;
+        for(size_t k = 0; k < puntos; k += GRUPO){
+            const size_t cuantos = std::min(GRUPO, puntos - k);
+            const double* px = x + k;
+            const double* py = y + k;
+            double gx[GRUPO] = {}, gy[GRUPO] = {};
+            if(cuantos < GRUPO){
+                std::copy_n(px, cuantos, gx);
+                std::copy_n(py, cuantos, gy);
+                px = gx;
+                py = gy;
+            }
+            __m128d vx[4], vy[4], e[4], falla[4];
+            for(size_t r = 0; r < 4; r++){
+                vx[r] = _mm_loadu_pd(px + 2 * r);
+                vy[r] = _mm_loadu_pd(py + 2 * r);
+                e[r] = _mm_max_pd(uno, _mm_max_pd(_mm_andnot_pd(signo, vx[r]), _mm_andnot_pd(signo, vy[r])));
+                falla[r] = _mm_setzero_pd();
+            }
+            for(size_t i = 0; i < n; i++){
+                const __m128d a = _mm_set1_pd(t.na[i]);
+                const __m128d b = _mm_set1_pd(t.nb[i]);
+                const __m128d c = _mm_set1_pd(t.nc[i]);
+                const __m128d tol = _mm_set1_pd(t.tol[i]);
+                const __m128d quitar = _mm_and_pd(_mm_set1_pd(t.igualdad[i]), signo);
+                for(size_t r = 0; r < 4; r++){
+                    __m128d v = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(a, vx[r]), _mm_mul_pd(b, vy[r])), c);
+                    v = _mm_andnot_pd(quitar, v);
+                    falla[r] = _mm_or_pd(falla[r], _mm_cmpnle_pd(v, _mm_mul_pd(tol, e[r])));
+                }
+                if(i % BLOQUE == BLOQUE - 1){
+                    __m128d todas = _mm_and_pd(_mm_and_pd(falla[0], falla[1]), _mm_and_pd(falla[2], falla[3]));
+                    if(_mm_movemask_pd(todas) == 0x3)
+                        break;
+                }
+            }
+            for(size_t r = 0; r < 4; r++){
+                int bits = _mm_movemask_pd(falla[r]);
+                for(size_t l = 0; l < 2 && 2 * r + l < cuantos; l++){
+                    factible[k + 2 * r + l] = !((bits >> l) & 1);
+                    total += factible[k + 2 * r + l];
+                }
+            }
+        }
+        return total;
+    }
+
+    __attribute__((target("avx2")))
+    size_t Factibles_avx2(const Tabla& t, const double* x, const double* y, size_t puntos, uint8_t* factible){
+        const size_t GRUPO = 16;  // 4 registros de 4 puntos
+        const size_t n = t.Tamano();
+        const __m256d signo = _mm256_set1_pd(-0.0);
+        const __m256d uno = _mm256_set1_pd(1.0);
+        size_t total = 0;
+        for(size_t k = 0; k < puntos; k += GRUPO){
+            const size_t cuantos = std::min(GRUPO, puntos - k);
+            const double* px = x + k;
+            const double* py = y + k;
+            double gx[GRUPO] = {}, gy[GRUPO] = {};
+            if(cuantos < GRUPO){
+                std::copy_n(px, cuantos, gx);
+                std::copy_n(py, cuantos, gy);
+                px = gx;
+                py = gy;
+            }
+            __m256d vx[4], vy[4], e[4], falla[4];
+            for(size_t r = 0; r < 4; r++){
+                vx[r] = _mm256_loadu_pd(px + BLOQUE * r);
+                vy[r] = _mm256_loadu_pd(py + BLOQUE * r);
+                e[r] = _mm256_max_pd(uno, _mm256_max_pd(_mm256_andnot_pd(signo, vx[r]), _mm256_andnot_pd(signo, vy[r])));
+                falla[r] = _mm256_setzero_pd();
+            }
+            for(size_t i = 0; i < n; i++){
+                const __m256d a = _mm256_broadcast_sd(&t.na[i]);
+                const __m256d b = _mm256_broadcast_sd(&t.nb[i]);
+                const __m256d c = _mm256_broadcast_sd(&t.nc[i]);
+                const __m256d tol = _mm256_broadcast_sd(&t.tol[i]);
+                const __m256d quitar = _mm256_and_pd(_mm256_broadcast_sd(&t.igualdad[i]), signo);
+                for(size_t r = 0; r < 4; r++){
+                    __m256d v = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(a, vx[r]), _mm256_mul_pd(b, vy[r])), c);
+                    v = _mm256_andnot_pd(quitar, v);
+                    falla[r] = _mm256_or_pd(falla[r], _mm256_cmp_pd(v, _mm256_mul_pd(tol, e[r]), _CMP_NLE_UQ));
+                }
+                if(i % BLOQUE == BLOQUE - 1){
+                    __m256d todas = _mm256_and_pd(_mm256_and_pd(falla[0], falla[1]), _mm256_and_pd(falla[2], falla[3]));
+                    if(_mm256_movemask_pd(todas) == 0xF)
+                        break;
+                }
+            }
+            for(size_t r = 0; r < 4; r++){
+                int bits = _mm256_movemask_pd(falla[r]);
+                for(size_t l = 0; l < BLOQUE && BLOQUE * r + l < cuantos; l++){
+                    factible[k + BLOQUE * r + l] = !((bits >> l) & 1);
+                    total += factible[k + BLOQUE * r + l];
+                }
+            }
+        }
+        return total;
+    }
+#endif
+
+    enum class Kernel { Escalar, SSE2, AVX2 };
+    typedef bool (*Funcion_factible)(const Tabla&, double, double);
+    typedef size_t (*Funcion_factibles)(const Tabla&, const double*, const double*, size_t, uint8_t*);
+
+    const char* Nombre_kernel(Kernel k){
+        switch(k){
+            case Kernel::Escalar: return "escalar";
+            case Kernel::SSE2:    return "sse2";
+            case Kernel::AVX2:    return "avx2";
+        }
+        return "";
+    }
+
+    // El mejor kernel que soporta el procesador
+    Kernel Kernel_disponible(){
+#ifdef RST_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return Kernel::AVX2;
+        if(__builtin_cpu_supports("sse2")) return Kernel::SSE2;
+#endif
+        return Kernel::Escalar;
+    }
+
+    // Función de un kernel; si el procesador no lo soporta, la escalar
+    Funcion_factible Funcion_kernel(Kernel k){
+#ifdef RST_X86
+        if(k == Kernel::AVX2 && __builtin_cpu_supports("avx2")) return Factible_avx2;
+        if(k == Kernel::SSE2 && __builtin_cpu_supports("sse2")) return Factible_sse2;
+#endif
+        (void)k;
+        return Factible_escalar;
+    }
+
+    // Igual que Funcion_kernel, para los kernels por lotes
+    Funcion_factibles Funcion_kernel_lote(Kernel k){
+#ifdef RST_X86
+        if(k == Kernel::AVX2 && __builtin_cpu_supports("avx2")) return Factibles_avx2;
+        if(k == Kernel::SSE2 && __builtin_cpu_supports("sse2")) return Factibles_sse2;
+#endif
+        (void)k;
+        return Factibles_escalar;
+    }
+
+    // true si (x, y) cumple todas las restricciones
+    bool Factible(const Tabla& t, double x, double y){
+        static const Funcion_factible funcion = Funcion_kernel(Kernel_disponible());
+        return funcion(t, x, y);
+    }
+
+    /**
+     * Revisa un lote de puntos contra toda la tabla; factible[k] queda en 1
+     * si el punto k la cumple. Devuelve cuántos la cumplen.
+     */
+    size_t Factibles(const Tabla& t, const double* x, const double* y, size_t puntos, uint8_t* factible){
+        static const Funcion_factibles funcion = Funcion_kernel_lote(Kernel_disponible());
+        return funcion(t, x, y, puntos, factible);
+    }
+}
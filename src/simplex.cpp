@@ -0,0 +1,821 @@
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+
+//////////////////////////////////////////////////////////////////////
+// Simplex revisado con cotas para n variables.                      //
+//                                                                    //
+// Cada restricción  a·x {<,>,=} b  se escribe como  a·x + s = b  con //
+// una holgura s acotada ([0,inf), (-inf,0] o [0,0]), así la base      //
+// inicial es la identidad. Como hay pocas variables y muchas          //
+// restricciones, de la base solo se invierte el núcleo K formado por  //
+// las estructurales básicas (k <= n); su inversa se actualiza en      //
+// O(k^2) por pivote y se recalcula cada cierto número de pivotes.     //
+// La fase 1 minimiza la suma de infactibilidades con paso largo.      //
+//////////////////////////////////////////////////////////////////////
+
+namespace SPX {
+
+    const double INF = std::numeric_limits<double>::infinity();
+
+    enum class Sentido { Maximizar, Minimizar };
+    enum class Estado { Optimo, No_acotado, Infactible, Limite_iteraciones };
+
+    const char* Nombre_estado(Estado estado){
+        switch(estado){
+            case Estado::Optimo:             return "optimo";
+            case Estado::No_acotado:         return "no_acotado";
+            case Estado::Infactible:         return "infactible";
+            case Estado::Limite_iteraciones: return "limite_iteraciones";
+        }
+        return "";
+    }
+
+    struct Resultado {
+        Estado estado = Estado::Infactible;
+        double valor = 0;               // valor de la función objetivo
+        std::vector<double> x;          // valores de las variables
+        size_t iteraciones = 0;
+        size_t pivotes_degenerados = 0;
+        bool degenerada = false;        // alguna variable básica quedó en su cota
+    };
+
+    /**
+     * Modelo lineal con las restricciones guardadas por renglón en forma
+     * dispersa (solo coeficientes distintos de cero). Por defecto cada
+     * variable está acotada a [0, inf).
+     */
+    class Modelo {
+        private:
+        size_t variables;
+        Sentido sentido = Sentido::Maximizar;
+        std::vector<double> objetivo;
+        std::vector<double> inferior, superior;
+        // Renglones en formato disperso (CSR)
+        std::vector<size_t> inicio_renglon {0};
+        std::vector<size_t> columna;
+        std::vector<double> coeficiente;
+        std::vector<char> operador;
+        std::vector<double> resultado;
+
+        friend class Simplex;
+
+        public:
+        Modelo(size_t variables = 0);
+        size_t Variables() const { return variables; }
+        size_t Restricciones() const { return operador.size(); }
+        Sentido Obtener_sentido() const { return sentido; }
+        void Fijar_sentido(Sentido s) { sentido = s; }
+        void Fijar_objetivo(size_t j, double c) { objetivo[j] = c; }
+        double Coef_objetivo(size_t j) const { return objetivo[j]; }
+        void Fijar_cota(size_t j, double l, double u) { inferior[j] = l; superior[j] = u; }
+        double Cota_inferior(size_t j) const { return inferior[j]; }
+        double Cota_superior(size_t j) const { return superior[j]; }
+        bool Agregar_restriccion(const std::vector<double>& coef, char op, double rhs);
+        void Renglon(size_t i, std::vector<double>& coef, char& op, double& rhs) const;
+    };
+
+    Modelo::Modelo(size_t variables){
+        this->variables = variables;
+        objetivo.assign(variables, 0.0);
+        inferior.assign(variables, 0.0);
+        superior.assign(variables, INF);
+    }
+
+    bool Modelo::Agregar_restriccion(const std::vector<double>& coef, char op, double rhs){
+        if(op != '<' && op != '>' && op != '=')
+            return false;
+        for(size_t j = 0; j < coef.size() && j < variables; j++){
+            if(coef[j] != 0.0){
+                columna.push_back(j);
+                coeficiente.push_back(coef[j]);
+            }
+        }
+        inicio_renglon.push_back(columna.size());
+        operador.push_back(op);
+        resultado.push_back(rhs);
+        return true;
+    }
+
+    void Modelo::Renglon(size_t i, std::vector<double>& coef, char& op, double& rhs) const {
+        coef.assign(variables, 0.0);
+        for(size_t k = inicio_renglon[i]; k < inicio_renglon[i + 1]; k++)
+            coef[columna[k]] = coeficiente[k];
+        op = operador[i];
+        rhs = resultado[i];
+    }
+
+    class Simplex {
+        private:
+        enum class Situacion { Basica, Inferior, Superior, Libre };
+
+        // Punto de quiebre de la fase 1 al recorrer la dirección de la entrante
+        struct Quiebre {
+            double paso;
+            double pendiente;    // cuánto aumenta la pendiente al cruzarlo
+            size_t variable;
+            bool a_superior;     // la variable queda en su cota superior
+        };
+
+        size_t n, m, total;
+        std::vector<double> costo, inferior, superior, b;
+        // Matriz de restricciones por columnas (CSC) y por renglones (CSR)
+        std::vector<size_t> inicio_columna, renglon;
+        std::vector<double> valor_columna;
+        std::vector<size_t> inicio_renglon, columna;
+        std::vector<double> valor_renglon;
+
+        std::vector<double> x;
+        std::vector<Situacion> situacion;
+
+        // Núcleo de la base: estructurales básicas y renglones cuya holgura no es básica.
+        // Con la base permutada como [[K, 0], [A_RS, I]] basta invertir K (k x k, k <= n).
+        std::vector<size_t> nucleo_col, nucleo_ren;
+        std::vector<size_t> pos_col, pos_ren;      // índice dentro del núcleo o NINGUNO
+        std::vector<double> inversa;               // K^-1 con paso 'dim'
+        size_t dim;
+
+        // alfa = B^-1 a_q separado en estructurales (por índice del núcleo) y holguras (por renglón)
+        std::vector<double> alfa_col, alfa_ren;
+        std::vector<double> duales, aux;
+        std::vector<Quiebre> quiebres;
+        // Pesos Devex (aproximación del borde más inclinado) y renglón pivote de B^-1
+        std::vector<double> peso, rho;
+
+        static constexpr size_t NINGUNO = std::numeric_limits<size_t>::max();
+        static constexpr double TOL_FACT = 1e-7;
+        static constexpr double TOL_OPT = 1e-9;
+        static constexpr double TOL_PIV = 1e-9;
+        static constexpr size_t REFACTORIZAR = 100;
+        static constexpr size_t RACHA_BLAND = 50;
+
+        double& K(size_t a, size_t c) { return inversa[a * dim + c]; }
+        bool Holgura_basica(size_t i) const { return pos_ren[i] == NINGUNO; }
+        void Ftran(size_t q);
+        void Btran(bool fase1);
+        bool Refactorizar();
+        void Calcular_basicas();
+        void Fila_por_inversa(size_t r);
+        void Actualizar_pesos(size_t q, size_t sale, double alfa_rq);
+        void Actualizar_nucleo(size_t q, size_t sale);
+        void Quitar_del_nucleo(size_t a, size_t c);
+        double Infactibilidad(size_t j) const;
+        double Reducido(size_t j, bool fase1) const;
+
+        public:
+        Simplex(const Modelo& modelo);
+        Resultado Resolver(size_t max_iteraciones);
+    };
+
+    Simplex::Simplex(const Modelo& modelo){
+        n = modelo.variables;
+        m = modelo.Restricciones();
+        total = n + m;
+        double signo = (modelo.sentido == Sentido::Maximizar) ? -1.0 : 1.0;
+
+        costo.assign(total, 0.0);
+        inferior.assign(total, 0.0);
+        superior.assign(total, 0.0);
+        for(size_t j = 0; j < n; j++){
+            costo[j] = signo * modelo.objetivo[j];
+            inferior[j] = modelo.inferior[j];
+            superior[j] = modelo.superior[j];
+        }
+        b = modelo.resultado;
+        for(size_t i = 0; i < m; i++){
+            switch(modelo.operador[i]){
+                case '<': inferior[n + i] = 0.0;  superior[n + i] = INF; break;
+                case '>': inferior[n + i] = -INF; superior[n + i] = 0.0; break;
+                default:  inferior[n + i] = 0.0;  superior[n + i] = 0.0; break;
+            }
+        }
+
+        inicio_renglon = modelo.inicio_renglon;
+        columna = modelo.columna;
+        valor_renglon = modelo.coeficiente;
+
+        // Transponer los renglones a columnas
+        inicio_columna.assign(n + 1, 0);
+        for(size_t j : columna) inicio_columna[j + 1]++;
+        for(size_t j = 0; j < n; j++) inicio_columna[j + 1] += inicio_columna[j];
+        renglon.resize(columna.size());
+        valor_columna.resize(columna.size());
+        std::vector<size_t> siguiente(inicio_columna.begin(), inicio_columna.end() - 1);
+        for(size_t i = 0; i < m; i++){
+            for(size_t k = inicio_renglon[i]; k < inicio_renglon[i + 1]; k++){
+                size_t pos = siguiente[columna[k]]++;
+                renglon[pos] = i;
+                valor_columna[pos] = valor_renglon[k];
+            }
+        }
+
+        // Base inicial: todas las holguras (núcleo vacío); estructurales en una cota
+        x.assign(total, 0.0);
+        situacion.assign(total, Situacion::Basica);
+        for(size_t j = 0; j < n; j++){
+            if(inferior[j] > -INF)      situacion[j] = Situacion::Inferior;
+            else if(superior[j] < INF)  situacion[j] = Situacion::Superior;
+            else                        situacion[j] = Situacion::Libre;
+        }
+        dim = std::min(n, m);
+        inversa.assign(dim * dim, 0.0);
+        pos_col.assign(n, NINGUNO);
+        pos_ren.assign(m, NINGUNO);
+        alfa_col.resize(dim);
+        alfa_ren.resize(m);
+        duales.resize(m);
+        aux.resize(std::max(dim, m));
+        peso.assign(total, 1.0);
+        rho.resize(m);
+        Calcular_basicas();
+    }
+
+    /**
+     * alfa = B^-1 a_q. Con B = [[K, 0], [A_RS, I]]:
+     *   alfa_col = K^-1 a_q(R)   y   alfa_ren = a_q(holguras básicas) - A_RS alfa_col
+     */
+    void Simplex::Ftran(size_t q){
+        size_t k = nucleo_col.size();
+        std::fill(alfa_col.begin(), alfa_col.begin() + k, 0.0);
+        std::fill(alfa_ren.begin(), alfa_ren.end(), 0.0);
+        if(q < n){
+            for(size_t p = inicio_columna[q]; p < inicio_columna[q + 1]; p++){
+                size_t i = renglon[p];
+                double v = valor_columna[p];
+                if(Holgura_basica(i)){
+                    alfa_ren[i] = v;
+                }
+                else{
+                    size_t c = pos_ren[i];
+                    for(size_t a = 0; a < k; a++) alfa_col[a] += K(a, c) * v;
+                }
+            }
+        }
+        else{
+            size_t c = pos_ren[q - n];
+            for(size_t a = 0; a < k; a++) alfa_col[a] = K(a, c);
+        }
+        for(size_t a = 0; a < k; a++){
+            double t = alfa_col[a];
+            if(t == 0.0) continue;
+            size_t s = nucleo_col[a];
+            for(size_t p = inicio_columna[s]; p < inicio_columna[s + 1]; p++)
+                if(Holgura_basica(renglon[p]))
+                    alfa_ren[renglon[p]] -= t * valor_columna[p];
+        }
+    }
+
+    /**
+     * duales^T = c_B^T B^-1. Las holguras básicas fijan su dual a su costo y
+     * los renglones del núcleo salen de (c_S - A_RS^T y_R) K^-1.
+     * En la fase 1 el costo de cada básica es -1, 0 o 1 según su infactibilidad.
+     */
+    void Simplex::Btran(bool fase1){
+        size_t k = nucleo_col.size();
+        auto c_basica = [&](size_t j){
+            if(!fase1) return costo[j];
+            double inf = Infactibilidad(j);
+            return inf < 0 ? -1.0 : (inf > 0 ? 1.0 : 0.0);
+        };
+        for(size_t i = 0; i < m; i++)
+            duales[i] = Holgura_basica(i) ? c_basica(n + i) : 0.0;
+        for(size_t a = 0; a < k; a++){
+            size_t s = nucleo_col[a];
+            double t = c_basica(s);
+            for(size_t p = inicio_columna[s]; p < inicio_columna[s + 1]; p++)
+                if(Holgura_basica(renglon[p]))
+                    t -= duales[renglon[p]] * valor_columna[p];
+            aux[a] = t;
+        }
+        for(size_t c = 0; c < k; c++){
+            double suma = 0.0;
+            for(size_t a = 0; a < k; a++) suma += aux[a] * K(a, c);
+            duales[nucleo_ren[c]] = suma;
+        }
+    }
+
+    double Simplex::Reducido(size_t j, bool fase1) const {
+        double d = fase1 ? 0.0 : costo[j];
+        if(j < n){
+            for(size_t p = inicio_columna[j]; p < inicio_columna[j + 1]; p++)
+                d -= duales[renglon[p]] * valor_columna[p];
+        }
+        else{
+            d -= duales[j - n];
+        }
+        return d;
+    }
+
+    /**
+     * Invierte K desde cero (Gauss-Jordan con pivoteo parcial). Si K resulta
+     * singular se regresa a la base de holguras y el simplex sigue desde ahí.
+     */
+    bool Simplex::Refactorizar(){
+        size_t k = nucleo_col.size();
+        std::vector<double> a(k * k * 2, 0.0);
+        size_t ancho = 2 * k;
+        for(size_t c = 0; c < k; c++){
+            size_t s = nucleo_col[c];
+            for(size_t p = inicio_columna[s]; p < inicio_columna[s + 1]; p++)
+                if(!Holgura_basica(renglon[p]))
+                    a[pos_ren[renglon[p]] * ancho + c] = valor_columna[p];
+        }
+        for(size_t r = 0; r < k; r++) a[r * ancho + k + r] = 1.0;
+
+        bool singular = false;
+        for(size_t c = 0; c < k && !singular; c++){
+            size_t piv = c;
+            for(size_t r = c + 1; r < k; r++)
+                if(std::abs(a[r * ancho + c]) > std::abs(a[piv * ancho + c])) piv = r;
+            if(std::abs(a[piv * ancho + c]) < TOL_PIV){
+                singular = true;
+                break;
+            }
+            if(piv != c)
+                for(size_t t = 0; t < ancho; t++) std::swap(a[c * ancho + t], a[piv * ancho + t]);
+            double d = 1.0 / a[c * ancho + c];
+            for(size_t t = 0; t < ancho; t++) a[c * ancho + t] *= d;
+            for(size_t r = 0; r < k; r++){
+                double f = a[r * ancho + c];
+                if(r == c || f == 0.0) continue;
+                for(size_t t = 0; t < ancho; t++) a[r * ancho + t] -= f * a[c * ancho + t];
+            }
+        }
+
+        if(singular){
+            for(size_t s : nucleo_col){
+                pos_col[s] = NINGUNO;
+                if(inferior[s] > -INF)      situacion[s] = Situacion::Inferior;
+                else if(superior[s] < INF)  situacion[s] = Situacion::Superior;
+                else                        situacion[s] = Situacion::Libre;
+            }
+            for(size_t i : nucleo_ren){
+                pos_ren[i] = NINGUNO;
+                situacion[n + i] = Situacion::Basica;
+            }
+            nucleo_col.clear();
+            nucleo_ren.clear();
+        }
+        else{
+            // a = [I | K^-1] con renglones por núcleo_ren; K^-1 va de R a S
+            for(size_t r = 0; r < k; r++)
+                for(size_t c = 0; c < k; c++)
+                    K(r, c) = a[r * ancho + k + c];
+        }
+        Calcular_basicas();
+        return !singular;
+    }
+
+    // x_B = B^-1 (b - N x_N)
+    void Simplex::Calcular_basicas(){
+        for(size_t j = 0; j < total; j++){
+            if(situacion[j] == Situacion::Inferior) x[j] = inferior[j];
+            else if(situacion[j] == Situacion::Superior) x[j] = superior[j];
+            else if(situacion[j] == Situacion::Libre) x[j] = 0.0;
+        }
+        std::vector<double> r = b;
+        for(size_t j = 0; j < n; j++){
+            if(situacion[j] == Situacion::Basica || x[j] == 0.0) continue;
+            for(size_t p = inicio_columna[j]; p < inicio_columna[j + 1]; p++)
+                r[renglon[p]] -= valor_columna[p] * x[j];
+        }
+        for(size_t i = 0; i < m; i++)
+            if(!Holgura_basica(i))
+                r[i] -= x[n + i];
+
+        size_t k = nucleo_col.size();
+        for(size_t a = 0; a < k; a++){
+            double suma = 0.0;
+            for(size_t c = 0; c < k; c++) suma += K(a, c) * r[nucleo_ren[c]];
+            x[nucleo_col[a]] = suma;
+            for(size_t p = inicio_columna[nucleo_col[a]]; p < inicio_columna[nucleo_col[a] + 1]; p++)
+                r[renglon[p]] -= valor_columna[p] * suma;
+        }
+        for(size_t i = 0; i < m; i++)
+            if(Holgura_basica(i))
+                x[n + i] = r[i];
+    }
+
+    // < 0 si la variable está debajo de su cota inferior, > 0 si está arriba de la superior
+    double Simplex::Infactibilidad(size_t j) const {
+        if(x[j] < inferior[j] - TOL_FACT) return x[j] - inferior[j];
+        if(x[j] > superior[j] + TOL_FACT) return x[j] - superior[j];
+        return 0.0;
+    }
+
+    // Quita del núcleo la columna a y el renglón c moviendo los últimos a su lugar
+    void Simplex::Quitar_del_nucleo(size_t a, size_t c){
+        size_t u = nucleo_col.size() - 1;
+        if(a != u)
+            for(size_t t = 0; t <= u; t++) K(a, t) = K(u, t);
+        if(c != u)
+            for(size_t t = 0; t <= u; t++) K(t, c) = K(t, u);
+        pos_col[nucleo_col[a]] = NINGUNO;
+        pos_ren[nucleo_ren[c]] = NINGUNO;
+        nucleo_col[a] = nucleo_col[u];
+        nucleo_ren[c] = nucleo_ren[u];
+        if(a != u) pos_col[nucleo_col[a]] = a;
+        if(c != u) pos_ren[nucleo_ren[c]] = c;
+        nucleo_col.pop_back();
+        nucleo_ren.pop_back();
+    }
+
+    // aux = A(r, S) K^-1, usado cuando sale la holgura del renglón r
+    void Simplex::Fila_por_inversa(size_t r){
+        size_t k = nucleo_col.size();
+        std::fill(aux.begin(), aux.begin() + k, 0.0);
+        for(size_t p = inicio_renglon[r]; p < inicio_renglon[r + 1]; p++){
+            size_t a = pos_col[columna[p]];
+            if(a == NINGUNO) continue;
+            double v = valor_renglon[p];
+            for(size_t c = 0; c < k; c++) aux[c] += v * K(a, c);
+        }
+    }
+
+    /**
+     * Pesos Devex: con el renglón pivote rho = e_r^T B^-1 se calcula alfa_rj
+     * para cada no básica y se actualiza  w_j = max(w_j, (alfa_rj/alfa_rq)^2 w_q).
+     * Se llama antes de actualizar el núcleo.
+     */
+    void Simplex::Actualizar_pesos(size_t q, size_t sale, double alfa_rq){
+        size_t k = nucleo_col.size();
+        std::fill(rho.begin(), rho.end(), 0.0);
+        if(sale < n){
+            size_t a0 = pos_col[sale];
+            for(size_t c = 0; c < k; c++) rho[nucleo_ren[c]] = K(a0, c);
+        }
+        else{
+            Fila_por_inversa(sale - n);
+            for(size_t c = 0; c < k; c++) rho[nucleo_ren[c]] = -aux[c];
+            rho[sale - n] = 1.0;
+        }
+        for(size_t j = 0; j < total; j++){
+            if(situacion[j] == Situacion::Basica || j == q) continue;
+            double alfa_rj = 0.0;
+            if(j < n){
+                for(size_t p = inicio_columna[j]; p < inicio_columna[j + 1]; p++)
+                    alfa_rj += rho[renglon[p]] * valor_columna[p];
+            }
+            else{
+                alfa_rj = rho[j - n];
+            }
+            if(alfa_rj != 0.0){
+                double r = alfa_rj / alfa_rq;
+                peso[j] = std::max(peso[j], r * r * peso[q]);
+            }
+        }
+        peso[sale] = std::max(peso[q] / (alfa_rq * alfa_rq), 1.0);
+    }
+
+    /**
+     * Actualiza K^-1 en O(k^2) después del pivote (q entra, sale deja la base):
+     *   estructural entra / holgura sale:    K crece un renglón y una columna
+     *   holgura entra / estructural sale:    K pierde un renglón y una columna
+     *   estructural por estructural:         cambia una columna de K
+     *   holgura por holgura:                 cambia un renglón de K
+     */
+    void Simplex::Actualizar_nucleo(size_t q, size_t sale){
+        size_t k = nucleo_col.size();
+        if(q < n && sale >= n){
+            size_t r = sale - n;
+            double delta = alfa_ren[r];
+            Fila_por_inversa(r);
+            for(size_t a = 0; a < k; a++)
+                for(size_t c = 0; c < k; c++)
+                    K(a, c) += alfa_col[a] * aux[c] / delta;
+            for(size_t a = 0; a < k; a++) K(a, k) = -alfa_col[a] / delta;
+            for(size_t c = 0; c < k; c++) K(k, c) = -aux[c] / delta;
+            K(k, k) = 1.0 / delta;
+            nucleo_col.push_back(q);
+            nucleo_ren.push_back(r);
+            pos_col[q] = k;
+            pos_ren[r] = k;
+        }
+        else if(q >= n && sale < n){
+            size_t a0 = pos_col[sale], c0 = pos_ren[q - n];
+            double piv = K(a0, c0);
+            for(size_t a = 0; a < k; a++){
+                if(a == a0) continue;
+                double f = K(a, c0) / piv;
+                if(f == 0.0) continue;
+                for(size_t c = 0; c < k; c++)
+                    if(c != c0) K(a, c) -= f * K(a0, c);
+            }
+            Quitar_del_nucleo(a0, c0);
+        }
+        else if(q < n && sale < n){
+            size_t a0 = pos_col[sale];
+            double piv = alfa_col[a0];
+            for(size_t c = 0; c < k; c++) K(a0, c) /= piv;
+            for(size_t a = 0; a < k; a++){
+                if(a == a0 || alfa_col[a] == 0.0) continue;
+                for(size_t c = 0; c < k; c++) K(a, c) -= alfa_col[a] * K(a0, c);
+            }
+            pos_col[sale] = NINGUNO;
+            nucleo_col[a0] = q;
+            pos_col[q] = a0;
+        }
+        else{
+            size_t r = sale - n, c0 = pos_ren[q - n];
+            Fila_por_inversa(r);
+            double piv = aux[c0];
+            for(size_t a = 0; a < k; a++) K(a, c0) /= piv;
+            for(size_t c = 0; c < k; c++){
+                if(c == c0 || aux[c] == 0.0) continue;
+                for(size_t a = 0; a < k; a++) K(a, c) -= aux[c] * K(a, c0);
+            }
+            pos_ren[q - n] = NINGUNO;
+            nucleo_ren[c0] = r;
+            pos_ren[r] = c0;
+        }
+    }
+
+    Resultado Simplex::Resolver(size_t max_iteraciones){
+        Resultado res;
+        size_t racha_degenerada = 0;
+        size_t desde_refactorizar = 0;
+        bool recien_refactorizada = false;   // x y duales salen de una K recién invertida
+
+        // Una variable con l > u (posible al armar el Modelo por código) no admite ningún valor
+        for(size_t j = 0; j < n; j++){
+            if(!(inferior[j] <= superior[j])){
+                res.estado = Estado::Infactible;
+                res.x.assign(x.begin(), x.begin() + n);
+                return res;
+            }
+        }
+
+        for(res.iteraciones = 0; res.iteraciones < max_iteraciones; res.iteraciones++){
+            // 1) Fase 1 mientras alguna básica esté fuera de sus cotas
+            bool fase1 = false;
+            for(size_t a = 0; a < nucleo_col.size() && !fase1; a++)
+                fase1 = Infactibilidad(nucleo_col[a]) != 0.0;
+            for(size_t i = 0; i < m && !fase1; i++)
+                fase1 = Holgura_basica(i) && Infactibilidad(n + i) != 0.0;
+            Btran(fase1);
+
+            // 2) Precio: Devex, o Bland si hay una racha de pivotes degenerados
+            bool bland = racha_degenerada > RACHA_BLAND;
+            size_t q = total;
+            double mejor = 0.0, d_q = 0.0;
+            for(size_t j = 0; j < total && !(bland && q != total); j++){
+                if(situacion[j] == Situacion::Basica || inferior[j] == superior[j]) continue;
+                double d = Reducido(j, fase1);
+                bool elegible = (situacion[j] == Situacion::Inferior && d < -TOL_OPT) ||
+                                (situacion[j] == Situacion::Superior && d > TOL_OPT) ||
+                                (situacion[j] == Situacion::Libre && std::abs(d) > TOL_OPT);
+                if(elegible && d * d / peso[j] > mejor){
+                    mejor = d * d / peso[j];
+                    q = j;
+                    d_q = d;
+                }
+            }
+
+            if(q == total){
+                if(fase1){
+                    res.estado = Estado::Infactible;
+                    return res;
+                }
+                // El óptimo se confirma con K invertida desde cero. Si resulta
+                // singular se regresa a las holguras y se sigue iterando (esa base
+                // no cuenta como confirmada); si los valores recalculados ya no
+                // son óptimos o factibles, también se sigue desde ahí.
+                if(!recien_refactorizada){
+                    recien_refactorizada = Refactorizar();
+                    desde_refactorizar = 0;
+                    continue;
+                }
+                res.estado = Estado::Optimo;
+                break;
+            }
+            recien_refactorizada = false;
+
+            // 3) Columna entrante transformada y prueba del cociente
+            Ftran(q);
+            double dir = (d_q < 0) ? 1.0 : -1.0;      // la entrante sube o baja
+            double paso = superior[q] - inferior[q];  // cambio de cota de la propia entrante
+            size_t sale = total;
+            bool sale_superior = false;
+            size_t k = nucleo_col.size();
+            auto alfa_de = [&](size_t j){ return j < n ? alfa_col[pos_col[j]] : alfa_ren[j - n]; };
+
+            if(fase1){
+                // Paso largo: se cruzan quiebres mientras la suma de infactibilidades siga bajando
+                quiebres.clear();
+                auto agregar = [&](size_t j, double alfa){
+                    if(std::abs(alfa) <= TOL_PIV) return;
+                    double tasa = -dir * alfa;
+                    double inf = Infactibilidad(j);
+                    double t = std::abs(tasa);
+                    if(tasa > 0){
+                        if(inf < 0) quiebres.push_back({(inferior[j] - x[j]) / tasa, t, j, false});
+                        if(inf <= 0 && superior[j] < INF)
+                            quiebres.push_back({std::max(0.0, (superior[j] - x[j]) / tasa), t, j, true});
+                    }
+                    else{
+                        if(inf > 0) quiebres.push_back({(x[j] - superior[j]) / t, t, j, true});
+                        if(inf >= 0 && inferior[j] > -INF)
+                            quiebres.push_back({std::max(0.0, (x[j] - inferior[j]) / t), t, j, false});
+                    }
+                };
+                for(size_t a = 0; a < k; a++) agregar(nucleo_col[a], alfa_col[a]);
+                for(size_t i = 0; i < m; i++) if(Holgura_basica(i)) agregar(n + i, alfa_ren[i]);
+                std::sort(quiebres.begin(), quiebres.end(),
+                          [](const Quiebre& p1, const Quiebre& p2){ return p1.paso < p2.paso; });
+                double pendiente = -std::abs(d_q);
+                for(const Quiebre& qb : quiebres){
+                    if(qb.paso >= paso) break;
+                    pendiente += qb.pendiente;
+                    if(pendiente >= -TOL_OPT || &qb == &quiebres.back()){
+                        paso = qb.paso;
+                        sale = qb.variable;
+                        sale_superior = qb.a_superior;
+                        break;
+                    }
+                }
+            }
+            else{
+                auto probar = [&](size_t j, double alfa){
+                    if(std::abs(alfa) <= TOL_PIV) return;
+                    double tasa = -dir * alfa;
+                    double limite = INF;
+                    bool a_superior = false;
+                    if(tasa > 0 && superior[j] < INF){ limite = (superior[j] - x[j]) / tasa; a_superior = true; }
+                    else if(tasa < 0 && inferior[j] > -INF) limite = (x[j] - inferior[j]) / -tasa;
+                    if(limite == INF) return;
+                    limite = std::max(limite, 0.0);
+                    if(limite < paso - TOL_FACT){
+                        paso = limite;
+                        sale = j;
+                        sale_superior = a_superior;
+                    }
+                    else if(sale != total && limite <= paso + TOL_FACT &&
+                            (bland ? j < sale : std::abs(alfa) > std::abs(alfa_de(sale)))){
+                        // Empate: Bland toma el menor índice, si no el pivote más grande
+                        paso = std::min(paso, limite);
+                        sale = j;
+                        sale_superior = a_superior;
+                    }
+                };
+                for(size_t a = 0; a < k; a++) probar(nucleo_col[a], alfa_col[a]);
+                for(size_t i = 0; i < m; i++) if(Holgura_basica(i)) probar(n + i, alfa_ren[i]);
+            }
+
+            if(paso == INF){
+                res.estado = fase1 ? Estado::Infactible : Estado::No_acotado;
+                return res;
+            }
+
+            // 4) Actualizar valores; si nada bloquea antes, la entrante cambia de cota
+            x[q] += dir * paso;
+            for(size_t a = 0; a < k; a++) x[nucleo_col[a]] -= dir * paso * alfa_col[a];
+            for(size_t i = 0; i < m; i++)
+                if(Holgura_basica(i) && alfa_ren[i] != 0.0)
+                    x[n + i] -= dir * paso * alfa_ren[i];
+
+            if(paso <= TOL_FACT){
+                res.pivotes_degenerados++;
+                racha_degenerada++;
+            }
+            else{
+                racha_degenerada = 0;
+            }
+
+            if(sale == total){
+                situacion[q] = (dir > 0) ? Situacion::Superior : Situacion::Inferior;
+                x[q] = (dir > 0) ? superior[q] : inferior[q];
+                continue;
+            }
+
+            Actualizar_pesos(q, sale, alfa_de(sale));
+            Actualizar_nucleo(q, sale);
+            situacion[sale] = sale_superior ? Situacion::Superior : Situacion::Inferior;
+            x[sale] = sale_superior ? superior[sale] : inferior[sale];
+            situacion[q] = Situacion::Basica;
+
+            if(++desde_refactorizar >= REFACTORIZAR){
+                Refactorizar();
+                desde_refactorizar = 0;
+            }
+        }
+
+        if(res.iteraciones >= max_iteraciones){
+            res.estado = Estado::Limite_iteraciones;
+            return res;
+        }
+
+        res.x.assign(x.begin(), x.begin() + n);
+        res.valor = 0.0;
+        for(size_t j = 0; j < n; j++) res.valor += costo[j] * x[j];
+        for(size_t j = 0; j < total; j++){
+            if(situacion[j] != Situacion::Basica) continue;
+            if(std::abs(x[j] - inferior[j]) <= TOL_FACT || std::abs(x[j] - superior[j]) <= TOL_FACT)
+                res.degenerada = true;
+        }
+        return res;
+    }
+
+    /**
+     * Resuelve el modelo. El valor reportado está en el sentido original
+     * (máximo o mínimo) del modelo.
+     */
+    Resultado Resolver(const Modelo& modelo, size_t max_iteraciones = 100000){
+        Simplex simplex(modelo);
+        Resultado res = simplex.Resolver(max_iteraciones);
+        if(modelo.Obtener_sentido() == Sentido::Maximizar)
+            res.valor = 0.0 - res.valor;
+        return res;
+    }
+
+    /**
+     * Lee un modelo de n variables. Formato (las líneas con "--" se ignoran):
+     *   max                  (o min)
+     *   3 5 4                (coeficientes del objetivo, definen n)
+     *   2 3 0 < 8            (restricción: n coeficientes, operador <, > o =, resultado)
+     *   cota 2 0 4           (opcional: cotas de x2; se acepta inf y -inf)
+     */
+    bool Leer_modelo(const std::string& archivo, Modelo& modelo){
+        std::ifstream in(archivo);
+        if(!in.is_open()){
+            std::cerr << "No se pudo abrir el archivo: " << archivo << std::endl;
+            return false;
+        }
+
+        auto numero = [](const std::string& s, double& v){
+            if(s == "inf" || s == "+inf") { v = INF; return true; }
+            if(s == "-inf") { v = -INF; return true; }
+            char* fin = nullptr;
+            v = std::strtod(s.c_str(), &fin);
+            return fin != s.c_str() && *fin == '\0';
+        };
+
+        std::string linea;
+        int estado = 0; // 0: sentido, 1: objetivo, 2: restricciones y cotas
+        Sentido sentido = Sentido::Maximizar;
+        size_t num_linea = 0;
+        while(std::getline(in, linea)){
+            num_linea++;
+            if(linea.rfind("--", 0) == 0) continue;
+            std::istringstream iss(linea);
+            std::vector<std::string> tokens;
+            std::string token;
+            while(iss >> token) tokens.push_back(token);
+            if(tokens.empty()) continue;
+
+            if(estado == 0){
+                if(tokens[0] == "max") sentido = Sentido::Maximizar;
+                else if(tokens[0] == "min") sentido = Sentido::Minimizar;
+                else{
+                    std::cerr << archivo << ":" << num_linea << ": se esperaba max o min\n";
+                    return false;
+                }
+                estado = 1;
+            }
+            else if(estado == 1){
+                std::vector<double> c(tokens.size());
+                for(size_t j = 0; j < tokens.size(); j++){
+                    if(!numero(tokens[j], c[j])){
+                        std::cerr << archivo << ":" << num_linea << ": coeficiente inválido\n";
+                        return false;
+                    }
+                }
+                modelo = Modelo(c.size());
+                modelo.Fijar_sentido(sentido);
+                for(size_t j = 0; j < c.size(); j++) modelo.Fijar_objetivo(j, c[j]);
+                estado = 2;
+            }
+            else if(tokens[0] == "cota"){
+                double j = 0, l = 0, u = 0;
+                if(tokens.size() != 4 || !numero(tokens[1], j) || !numero(tokens[2], l) || !numero(tokens[3], u)
+                   || j < 1 || j > modelo.Variables() || !(l <= u)){
+                    std::cerr << archivo << ":" << num_linea << ": cota inválida\n";
+                    return false;
+                }
+                modelo.Fijar_cota((size_t)j - 1, l, u);
+            }
+            else{
+                size_t nv = modelo.Variables();
+                std::vector<double> a(nv);
+                double rhs = 0;
+                bool valida = tokens.size() == nv + 2 && numero(tokens[nv + 1], rhs);
+                for(size_t j = 0; valida && j < nv; j++) valida = numero(tokens[j], a[j]);
+                char op = valida ? tokens[nv][0] : ' ';
+                if(!valida || !modelo.Agregar_restriccion(a, op, rhs)){
+                    std::cerr << archivo << ":" << num_linea << ": restricción inválida\n";
+                    return false;
+                }
+            }
+        }
+        if(estado < 2){
+            std::cerr << archivo << ": falta el sentido o la función objetivo\n";
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,275 @@
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cstdarg>
+#include <cstdint>
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////
+// Trazas de depuración con poco costo para el hilo que las emite.   //
+//                                                                    //
+// Los mensajes se formatean en una celda de un búfer circular sin    //
+// candados (varios productores, un consumidor) y un hilo aparte los   //
+// escribe en el archivo, que se rota al pasar de cierto tamaño. Si el //
+// búfer está lleno el mensaje se descarta y solo se cuenta.           //
+//                                                                    //
+// El nivel se fija al compilar con -DTRZ_NIVEL=n:                     //
+//   0 nada, 1 errores, 2 información (por defecto), 3 depuración      //
+// Con nivel 0 las macros no generan código, tampoco los cronómetros.  //
+//////////////////////////////////////////////////////////////////////
+
+#define TRZ_NIVEL_NADA 0
+#define TRZ_NIVEL_ERROR 1
+#define TRZ_NIVEL_INFO 2
+#define TRZ_NIVEL_DEPURACION 3
+
+#ifndef TRZ_NIVEL
+#define TRZ_NIVEL TRZ_NIVEL_INFO
+#endif
+
+namespace TRZ {
+
+    // Fases con cronómetro
+    enum Fase { Parseo, Interseccion, Filtrado, Dibujo, NUM_FASES };
+    const char* const NOMBRE_FASE[NUM_FASES] = { "parseo", "interseccion", "filtrado", "dibujo" };
+
+    // Contadores de eventos
+    enum Contador { Restricciones, Vertices, Lineas_achurado, Capas, Modelos, NUM_CONTADORES };
+    const char* const NOMBRE_CONTADOR[NUM_CONTADORES] = { "restricciones", "vertices", "lineas_achurado", "capas", "modelos" };
+
+    const size_t CAPACIDAD = 4096;  // potencia de 2
+    const size_t TAM_TEXTO = 224;
+
+    struct Celda {
+        std::atomic<size_t> secuencia;
+        uint64_t instante;          // ns desde el inicio
+        int nivel;
+        char texto[TAM_TEXTO];
+    };
+
+    // Búfer circular acotado (Vyukov): cada celda guarda el turno que le toca
+    struct Bufer {
+        Celda celdas[CAPACIDAD];
+        alignas(64) std::atomic<size_t> escritura{0};
+        alignas(64) size_t lectura = 0;     // solo lo toca el hilo que escribe el archivo
+
+        Bufer(){
+            for(size_t i = 0; i < CAPACIDAD; i++)
+                celdas[i].secuencia.store(i, std::memory_order_relaxed);
+        }
+
+        // Reserva una celda para escribir; nullptr si está lleno
+        Celda* Reservar(size_t& turno){
+            size_t pos = escritura.load(std::memory_order_relaxed);
+            while(true){
+                Celda* celda = &celdas[pos & (CAPACIDAD - 1)];
+                size_t sec = celda->secuencia.load(std::memory_order_acquire);
+                intptr_t diferencia = (intptr_t)sec - (intptr_t)pos;
+                if(diferencia == 0){
+                    if(escritura.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                        turno = pos;
+                        return celda;
+                    }
+                }
+                else if(diferencia < 0){
+                    return nullptr;
+                }
+                else{
+                    pos = escritura.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void Publicar(Celda* celda, size_t turno){
+            celda->secuencia.store(turno + 1, std::memory_order_release);
+        }
+
+        // Siguiente celda lista para leer; nullptr si no hay
+        Celda* Siguiente(){
+            Celda* celda = &celdas[lectura & (CAPACIDAD - 1)];
+            if(celda->secuencia.load(std::memory_order_acquire) != lectura + 1)
+                return nullptr;
+            return celda;
+        }
+
+        void Liberar(Celda* celda){
+            celda->secuencia.store(lectura + CAPACIDAD, std::memory_order_release);
+            lectura++;
+        }
+    };
+
+    // Estado global de las trazas
+    static Bufer bufer;
+    static std::atomic<uint64_t> descartados{0};
+    static std::atomic<uint64_t> tiempo_fase[NUM_FASES];
+    static std::atomic<uint64_t> veces_fase[NUM_FASES];
+    static std::atomic<uint64_t> contadores[NUM_CONTADORES];
+    static const std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+    static std::thread escritor;
+    static std::atomic<bool> activo{false};
+    static std::string archivo;
+    static size_t tam_maximo = 0;
+
+    static uint64_t Ahora(){
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    // Formatea el mensaje directamente en una celda del búfer
+    void Registrar(int nivel, const char* formato, ...){
+        size_t turno;
+        Celda* celda = bufer.Reservar(turno);
+        if(celda == nullptr){
+            descartados.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        celda->instante = Ahora();
+        celda->nivel = nivel;
+        va_list args;
+        va_start(args, formato);
+        vsnprintf(celda->texto, TAM_TEXTO, formato, args);
+        va_end(args);
+        bufer.Publicar(celda, turno);
+    }
+
+    void Contar(Contador contador, uint64_t cantidad){
+        contadores[contador].fetch_add(cantidad, std::memory_order_relaxed);
+    }
+
+    // Acumula el tiempo de una fase mientras exista
+    class Cronometro {
+        private:
+        Fase fase;
+        uint64_t desde;
+
+        public:
+        Cronometro(Fase fase){
+            this->fase = fase;
+            desde = Ahora();
+        }
+        ~Cronometro(){
+            tiempo_fase[fase].fetch_add(Ahora() - desde, std::memory_order_relaxed);
+            veces_fase[fase].fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    static const char* Nombre_nivel(int nivel){
+        switch(nivel){
+            case TRZ_NIVEL_ERROR: return "ERROR";
+            case TRZ_NIVEL_INFO:  return "INFO ";
+            default:              return "DEPUR";
+        }
+    }
+
+    // Escribe lo que haya en el búfer; antes de pasar del máximo rota el archivo
+    static void Vaciar(std::ofstream& salida, size_t& escritos){
+        Celda* celda;
+        char linea[TAM_TEXTO + 64];
+        while((celda = bufer.Siguiente()) != nullptr){
+            int n = snprintf(linea, sizeof(linea), "[%12.6f] %s %s\n",
+                             celda->instante / 1e9, Nombre_nivel(celda->nivel), celda->texto);
+            bufer.Liberar(celda);
+            size_t tam = std::min<size_t>(n, sizeof(linea) - 1);
+            if(tam_maximo > 0 && escritos > 0 && escritos + tam > tam_maximo){
+                salida.close();
+                std::string anterior = archivo + ".1";
+                std::rename(archivo.c_str(), anterior.c_str());
+                salida.open(archivo, std::ios::trunc);
+                escritos = 0;
+            }
+            salida.write(linea, tam);
+            escritos += tam;
+        }
+        salida.flush();
+    }
+
+    static void Escribir(){
+        std::ofstream salida(archivo, std::ios::trunc);
+        size_t escritos = 0;
+        while(activo.load(std::memory_order_acquire)){
+            Vaciar(salida, escritos);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        Vaciar(salida, escritos);
+    }
+
+    /**
+     * Arranca el hilo que escribe las trazas en "nombre" (se sobrescribe).
+     * Al pasar de tam_max bytes el archivo se renombra a "nombre.1" y se
+     * empieza otro; 0 es sin límite.
+     */
+    void Iniciar(const std::string& nombre, size_t tam_max = 1 << 20){
+        if(TRZ_NIVEL == TRZ_NIVEL_NADA || activo.exchange(true))
+            return;
+        archivo = nombre;
+        tam_maximo = tam_max;
+        escritor = std::thread(Escribir);
+    }
+
+    // Registra los tiempos por fase y los contadores acumulados
+    void Resumen(){
+        for(int f = 0; f < NUM_FASES; f++){
+            uint64_t veces = veces_fase[f].load(std::memory_order_relaxed);
+            if(veces == 0)
+                continue;
+            double ms = tiempo_fase[f].load(std::memory_order_relaxed) / 1e6;
+            Registrar(TRZ_NIVEL_INFO, "fase %s: %llu veces, %.3f ms (%.3f ms prom.)",
+                      NOMBRE_FASE[f], (unsigned long long)veces, ms, ms / veces);
+        }
+        for(int c = 0; c < NUM_CONTADORES; c++){
+            uint64_t valor = contadores[c].load(std::memory_order_relaxed);
+            if(valor > 0)
+                Registrar(TRZ_NIVEL_INFO, "contador %s: %llu", NOMBRE_CONTADOR[c], (unsigned long long)valor);
+        }
+        uint64_t perdidos = descartados.load(std::memory_order_relaxed);
+        if(perdidos > 0)
+            Registrar(TRZ_NIVEL_INFO, "mensajes descartados: %llu", (unsigned long long)perdidos);
+    }
+
+    // Escribe lo pendiente y detiene el hilo
+    void Detener(){
+        if(!activo.exchange(false))
+            return;
+        escritor.join();
+    }
+
+    // Trazas activas mientras viva el objeto; al final deja el resumen
+    class Sesion {
+        public:
+        Sesion(const std::string& nombre, size_t tam_max = 1 << 20){ Iniciar(nombre, tam_max); }
+        ~Sesion(){
+            Resumen();
+            Detener();
+        }
+    };
+}
+
+// Macros: con un nivel menor al del mensaje no generan código
+#define TRZ_CONCATENAR_(a, b) a##b
+#define TRZ_CONCATENAR(a, b) TRZ_CONCATENAR_(a, b)
+
+#if TRZ_NIVEL >= TRZ_NIVEL_ERROR
+#define TRZ_ERROR(...) TRZ::Registrar(TRZ_NIVEL_ERROR, __VA_ARGS__)
+#else
+#define TRZ_ERROR(...) ((void)0)
+#endif
+
+#if TRZ_NIVEL >= TRZ_NIVEL_INFO
+#define TRZ_INFO(...) TRZ::Registrar(TRZ_NIVEL_INFO, __VA_ARGS__)
+#define TRZ_FASE(fase) TRZ::Cronometro TRZ_CONCATENAR(cronometro_, __LINE__)(fase)
+#define TRZ_CONTAR(contador, cantidad) TRZ::Contar(contador, cantidad)
+#else
+#define TRZ_INFO(...) ((void)0)
+#define TRZ_FASE(fase) ((void)0)
+#define TRZ_CONTAR(contador, cantidad) ((void)0)
+#endif
+
+#if TRZ_NIVEL >= TRZ_NIVEL_DEPURACION
+#define TRZ_DEPURAR(...) TRZ::Registrar(TRZ_NIVEL_DEPURACION, __VA_ARGS__)
+#else
+#define TRZ_DEPURAR(...) ((void)0)
+#endif